@@ -0,0 +1,104 @@
+#include "BiasMath.h"
+#include "ProfileTable.h"
+#include "SpscRing.h"
+
+#include <benchmark/benchmark.h>
+
+// The per-dispatch work of the core: the bias formula and the profile lookup, plus the ring every
+// worker job goes through.
+
+static void BM_BiasCompute(benchmark::State& state)
+{
+	const BiasFormula formula;
+	FfxDimensions2D render{ 2560, 1440 };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(render);
+		benchmark::DoNotOptimize(BiasMath::Compute(render, { 3840, 2160 }, formula, 0.0f));
+	}
+}
+BENCHMARK(BM_BiasCompute);
+
+// FastLog2 against the library log2 it replaces, over render scales from a quarter to native
+template <class Log2>
+static void RunLog2(benchmark::State& state, Log2&& log2)
+{
+	std::array<float, 1024> ratios;
+	for (size_t i = 0; i < ratios.size(); i++)
+		ratios[i] = 0.25f + 0.75f * float(i) / float(ratios.size() - 1);
+
+	for (auto _ : state) {
+		for (const float ratio : ratios)
+			benchmark::DoNotOptimize(log2(ratio));
+	}
+	state.SetItemsProcessed(int64_t(state.iterations() * ratios.size()));
+}
+
+static void BM_FastLog2(benchmark::State& state)
+{
+	RunLog2(state, [](float x) { return BiasMath::FastLog2(x); });
+}
+BENCHMARK(BM_FastLog2);
+
+static void BM_StdLog2(benchmark::State& state)
+{
+	RunLog2(state, [](float x) { return std::log2(x); });
+}
+BENCHMARK(BM_StdLog2);
+
+static void BM_ProfileFind(benchmark::State& state)
+{
+	ProfileTable table;
+	for (uint32_t width = 640; width < 3840; width += 64)
+		table.AddPair("pair", 0.0f, width, width * 9 / 16, 3840, 2160);
+	table.AddScale("scale", 0.0f, 0.5f, 0.01f);
+	table.Compile();
+
+	uint32_t width = 1920;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(width);
+		benchmark::DoNotOptimize(table.Find(width, 1080, 3840, 2160));
+	}
+}
+BENCHMARK(BM_ProfileFind);
+
+static void BM_SpscPushPop(benchmark::State& state)
+{
+	SpscRing<uint64_t, 256> ring;
+	uint64_t value = 0;
+	for (auto _ : state) {
+		ring.Push(value);
+		ring.Pop(value);
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(BM_SpscPushPop);
+
+// Items a producer gets through to a consumer thread, including the time spent waiting on a full ring
+static void BM_SpscTransfer(benchmark::State& state)
+{
+	SpscRing<uint64_t, 256> ring;
+	std::atomic<bool> done = false;
+	uint64_t received = 0;
+
+	std::thread consumer([&] {
+		uint64_t value;
+		while (!done.load(std::memory_order_acquire) || !ring.Empty()) {
+			if (ring.Pop(value))
+				received++;
+			else
+				std::this_thread::yield();
+		}
+	});
+
+	uint64_t sent = 0;
+	for (auto _ : state) {
+		while (!ring.Push(sent))
+			std::this_thread::yield();
+		sent++;
+	}
+
+	done.store(true, std::memory_order_release);
+	consumer.join();
+	state.SetItemsProcessed(int64_t(received));
+}
+BENCHMARK(BM_SpscTransfer)->UseRealTime();
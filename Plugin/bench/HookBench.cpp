@@ -0,0 +1,116 @@
+#include "ContextPool.h"
+#include "FfxUtil.h"
+#include "Fsr2Hooks.h"
+#include "HookProfiler.h"
+#include "ffx_fsr2_mock.h"
+
+#include <benchmark/benchmark.h>
+
+// What the plugin adds to a dispatch: the full hook path against a direct call of the same FSR2 mock,
+// with hook telemetry on and off, the fix force-disabled and several contexts dispatched round robin.
+// Telemetry samples are drained on the benchmark thread, so those runs include what the worker does.
+// BM_HookOverhead runs the same hook in front of an empty dispatch, which leaves only the plugin's share.
+
+namespace
+{
+	constexpr FfxDimensions2D RenderSize{ 1920, 1080 };
+	constexpr FfxDimensions2D DisplaySize{ 3840, 2160 };
+
+	// Dispatches between trimming the mock's execution logs, and draining telemetry
+	constexpr size_t Housekeeping = 256;
+
+	// The first dispatch of a context clears its history in host memory, which would swamp everything else,
+	// so every context is dispatched once up front
+	std::vector<Mock::Harness> CreateContexts(size_t count, Fsr2Hooks::CreateFunc create, Fsr2Hooks::DispatchFunc dispatch)
+	{
+		std::vector<Mock::Harness> harnesses(count);
+		for (size_t i = 0; i < count; i++) {
+			auto description = harnesses[i].MakeContextDescription(RenderSize, DisplaySize, reinterpret_cast<FfxDevice>((0x100 + i) << 4));
+			create(harnesses[i].context.get(), &description);
+
+			auto warmUp = Mock::MakeDispatchDescription(RenderSize);
+			dispatch(harnesses[i].context.get(), &warmUp);
+		}
+		return harnesses;
+	}
+
+	void DestroyContexts(std::vector<Mock::Harness>& harnesses)
+	{
+		for (auto& harness : harnesses)
+			ffxFsr2ContextDestroyMock(harness.context.get());
+	}
+
+	void TrimLogs(std::vector<Mock::Harness>& harnesses)
+	{
+		for (auto& harness : harnesses)
+			Mock::GetBackendContext(FfxUtil::GetInterface(harness.context.get()))->executed.clear();
+	}
+}
+
+static void BM_DirectDispatch(benchmark::State& state)
+{
+	auto harnesses = CreateContexts(size_t(state.range(0)), &ffxFsr2ContextCreateMock, &ffxFsr2ContextDispatchMock);
+	auto dispatch = Mock::MakeDispatchDescription(RenderSize);
+
+	size_t i = 0;
+	for (auto _ : state) {
+		dispatch.reset = false;
+		benchmark::DoNotOptimize(ffxFsr2ContextDispatchMock(harnesses[i % harnesses.size()].context.get(), &dispatch));
+		if (++i % Housekeeping == 0)
+			TrimLogs(harnesses);
+	}
+
+	state.SetItemsProcessed(int64_t(state.iterations()));
+	DestroyContexts(harnesses);
+}
+BENCHMARK(BM_DirectDispatch)->ArgName("contexts")->Arg(1)->Arg(4);
+
+static void RunHooked(benchmark::State& state, Fsr2Hooks::DispatchFunc original)
+{
+	const bool telemetry = state.range(0) != 0;
+	HostLog::threshold = HostLog::Level::Error;
+
+	auto hooks = Fsr2Hooks::GetSingleton();
+	hooks->SetCreateOriginal(&ffxFsr2ContextCreateMock);
+	hooks->SetDispatchOriginal(original);
+	hooks->SetDispatchLayout(FfxLayout::Version::Fsr22);
+	hooks->forceDisable.store(state.range(1) != 0, std::memory_order_relaxed);
+
+	auto profiler = HookProfiler::GetSingleton();
+	profiler->enabled = telemetry;
+
+	auto harnesses = CreateContexts(size_t(state.range(2)), &Fsr2Hooks::ContextCreate_hook, &Fsr2Hooks::ContextDispatch_hook);
+	auto dispatch = Mock::MakeDispatchDescription(RenderSize);
+
+	size_t i = 0;
+	for (auto _ : state) {
+		dispatch.reset = false;
+		benchmark::DoNotOptimize(Fsr2Hooks::ContextDispatch_hook(harnesses[i % harnesses.size()].context.get(), &dispatch));
+		if (++i % Housekeeping == 0) {
+			TrimLogs(harnesses);
+			if (telemetry)
+				profiler->Drain();
+		}
+	}
+
+	state.SetItemsProcessed(int64_t(state.iterations()));
+	state.counters["dropped"] = double(profiler->GetDropped());
+
+	DestroyContexts(harnesses);
+	ContextPool::GetSingleton()->ReleaseAll();
+	profiler->enabled = false;
+	profiler->Reset();
+	hooks->forceDisable.store(false, std::memory_order_relaxed);
+}
+
+static void BM_HookedDispatch(benchmark::State& state)
+{
+	RunHooked(state, &ffxFsr2ContextDispatchMock);
+}
+BENCHMARK(BM_HookedDispatch)->ArgNames({ "telemetry", "force_disable", "contexts" })->ArgsProduct({ { 0, 1 }, { 0, 1 }, { 1, 4 } });
+
+static void BM_HookOverhead(benchmark::State& state)
+{
+	RunHooked(state, [](FfxFsr2Context*, FfxFsr2DispatchDescription*) -> FfxErrorCode { return FFX_OK; });
+}
+BENCHMARK(BM_HookOverhead)->ArgNames({ "telemetry", "force_disable", "contexts" })->ArgsProduct({ { 0, 1 }, { 0, 1 }, { 1, 4 } });
@@ -0,0 +1,23 @@
+# Warnings for every target except the plugin itself, which compiles the DKUtil and ReShade headers at /W0.
+# C4324 is MSVC noting the padding alignas(64) adds to the sharded metrics and ring indices, which is the
+# point of them.
+function(target_strict_warnings TARGET)
+	if (MSVC)
+		target_compile_options(
+			${TARGET}
+			PRIVATE
+				/W4
+				/WX
+				/wd4324
+		)
+	else()
+		target_compile_options(
+			${TARGET}
+			PRIVATE
+				-Wall
+				-Wextra
+				-Wconversion
+				-Werror
+		)
+	endif()
+endfunction()
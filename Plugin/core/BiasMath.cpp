@@ -0,0 +1,71 @@
+#include "BiasMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace BiasMath
+{
+	namespace
+	{
+		// Series reference for the compile time check, std::log2 is not constexpr
+		constexpr double ReferenceLog2(double x)
+		{
+			double exponent = 0.0;
+			for (; x >= 2.0; x /= 2.0)
+				exponent += 1.0;
+			for (; x < 1.0; x *= 2.0)
+				exponent -= 1.0;
+
+			// ln(x) = 2 atanh((x - 1) / (x + 1)), y <= 1/3 so 16 terms are far below float precision
+			const double y = (x - 1.0) / (x + 1.0);
+			double term = y, sum = 0.0;
+			for (int i = 1; i < 32; i += 2) {
+				sum += term / i;
+				term *= y * y;
+			}
+			return exponent + 2.0 * sum / 0.69314718055994531;
+		}
+
+		// Common display widths against render scales in 1/32 steps down to a quarter, kept small enough for
+		// the constexpr step limits of every compiler
+		constexpr bool IsWithinLog2Error()
+		{
+			for (const uint32_t display : { 1280u, 1920u, 2560u, 3440u, 3840u, 5120u, 7680u }) {
+				for (uint32_t step = 8; step <= 32; step++) {
+					const uint32_t render = display * step / 32;
+					const float ratio = float(render) / float(display);
+					const double error = double(FastLog2(ratio)) - ReferenceLog2(double(ratio));
+					if (error > Log2Error || error < -Log2Error)
+						return false;
+				}
+			}
+			return FastLog2(1.0f) == 0.0f && FastLog2(0.5f) == -1.0f && FastLog2(0.0f) == -Log2Limit;
+		}
+
+		static_assert(IsWithinLog2Error());
+	}
+
+	Result Compute(FfxDimensions2D renderSize, FfxDimensions2D displaySize, const BiasFormula& formula, float extraOffset)
+	{
+		Result result{};
+		if (!renderSize.width || !displaySize.width) {
+			result.outOfRange = true;
+			return result;
+		}
+
+		const float renderResolutionX = float(renderSize.width);
+		const float displayResolutionX = float(displaySize.width);
+
+		const float ratioBias = FastLog2(renderResolutionX / displayResolutionX);
+		const float clampedRatioBias = std::clamp(ratioBias, MinRatioBias, MaxRatioBias);
+
+		result.ratioBias = ratioBias;
+		result.outOfRange = ratioBias != clampedRatioBias;
+		result.bias = std::clamp(clampedRatioBias * formula.scale + formula.offset + extraOffset, formula.minBias, formula.maxBias);
+
+		// The formula and offsets come from the config file, which is validated, but a NaN there must still
+		// never reach the game setting
+		result.valid = std::isfinite(result.bias);
+		return result;
+	}
+}
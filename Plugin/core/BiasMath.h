@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ffx_fsr2.h"
+
+#include <bit>
+#include <cfloat>
+#include <cstdint>
+
+// How fMipBias follows the FSR2 render scale: bias = scale * log2(render width / display width) + offset,
+// clamped to [minBias, maxBias].
+struct BiasFormula
+{
+	float scale = 1.0f;
+	float offset = 0.0f;
+	float minBias = -10.0f;
+	float maxBias = 0.0f;
+};
+
+namespace BiasMath
+{
+	// log2(render / display) outside this range means the resolutions reported to us are wrong
+	constexpr float MinRatioBias = -10.0f;
+	constexpr float MaxRatioBias = 0.0f;
+
+	// FastLog2 is within Log2Error of log2 for x in [2^-10, 2^10], which holds every ratio Compute accepts
+	// and is checked for each float in it by the tests (worst 8e-6). Further out the exponent no longer fits
+	// next to the mantissa's bits in a float and the error grows, to about 1.13e-5 near 2^-126. Zero,
+	// negatives, denormals and NaN give -Log2Limit and infinity gives Log2Limit, both far outside any clamp
+	// applied to the result.
+	constexpr float Log2Error = 1e-5f;
+	constexpr float Log2Limit = 128.0f;
+
+	// Splits x into exponent and mantissa m in [1, 2) and evaluates log2(m) = t * q(t), t = m - 1, with q
+	// interpolated at Chebyshev nodes. t * q(t) is exactly 0 at t = 0 so powers of two, including a ratio of
+	// 1 at native resolution, come out exact. The range checks are selects, there are no branches.
+	constexpr float FastLog2(float x)
+	{
+		const auto bits = std::bit_cast<uint32_t>(x);
+		const float exponent = float(int32_t((bits >> 23) & 0xFF) - 127);
+		const float t = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000) - 1.0f;
+		const float q = 1.44268147f + t * (-0.720358773f + t * (0.468658879f + t * (-0.301638010f + t * (0.144471096f + t * -0.0338220460f))));
+		const float log = exponent + t * q;
+
+		// NaN fails both comparisons
+		return x > FLT_MAX ? Log2Limit : (x >= FLT_MIN ? log : -Log2Limit);
+	}
+
+	struct Result
+	{
+		float ratioBias;  // log2(render width / display width) as computed
+		float bias;       // after the formula, what should be applied
+		bool outOfRange;  // ratioBias was clamped before the formula
+		bool valid;       // false for a zero width or a non-finite result, bias must not be applied then
+	};
+
+	// extraOffset is added on top of the formula's own offset, for profiles and hot key offsets.
+	Result Compute(FfxDimensions2D renderSize, FfxDimensions2D displaySize, const BiasFormula& formula, float extraOffset);
+}
@@ -0,0 +1,43 @@
+#include "EventDecoder.h"
+
+#include <cstring>
+
+template <class Length>
+bool EventDecoder::ReadString(std::string& string)
+{
+	Length length;
+	if (!Read(length))
+		return false;
+	string.resize(length);
+	return length == 0 || static_cast<bool>(stream.read(string.data(), length));
+}
+
+EventDecoder::Status EventDecoder::ReadHeader()
+{
+	char magic[4];
+	uint16_t eventCount;
+	if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, EventFormat::Magic, sizeof(magic)) != 0 || !Read(version) || !Read(startTime) || !Read(eventCount))
+		return Status::NotEventLog;
+	if (version != EventFormat::Version)
+		return Status::UnsupportedVersion;
+
+	definitions.resize(eventCount);
+	for (auto& definition : definitions) {
+		if (!Read(definition.level) || !ReadString<uint8_t>(definition.name) || !ReadString<uint8_t>(definition.types) || !ReadString<uint16_t>(definition.format))
+			return Status::TruncatedHeader;
+	}
+	return Status::Ok;
+}
+
+EventDecoder::Status EventDecoder::Next(Record& record)
+{
+	if (!Read(record.event))
+		return Status::End;
+	if (!Read(record.suppressed) || !Read(record.time) || record.event >= definitions.size())
+		return Status::CorruptRecord;
+
+	record.args.assign(definitions[record.event].types.size(), {});
+	if (!record.args.empty() && !stream.read(reinterpret_cast<char*>(record.args.data()), std::streamsize(record.args.size() * sizeof(EventFormat::Arg))))
+		return Status::TruncatedRecord;
+	return Status::Ok;
+}
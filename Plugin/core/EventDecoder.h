@@ -0,0 +1,70 @@
+#pragma once
+
+#include "EventFormat.h"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// Reads a binary event log as laid out in EventFormat.h, for tools/event_decode and the decoder fuzz
+// target. Nothing in the file is trusted: every length, count and event index is checked against what
+// could actually be read, and a damaged file ends the records instead of being read past.
+class EventDecoder
+{
+public:
+	struct Definition
+	{
+		EventFormat::Level level;
+		std::string name;
+		std::string types;
+		std::string format;
+	};
+
+	struct Record
+	{
+		uint16_t event;
+		uint32_t suppressed;
+		int64_t time;
+		std::vector<EventFormat::Arg> args;  // one per type of the event
+	};
+
+	enum class Status
+	{
+		Ok,
+		End,
+		NotEventLog,
+		UnsupportedVersion,
+		TruncatedHeader,
+		CorruptRecord,
+		TruncatedRecord
+	};
+
+	explicit EventDecoder(std::istream& stream) :
+		stream(stream) {}
+
+	// Before the first Next.
+	Status ReadHeader();
+
+	// Status::End at the end of the file, any other failure leaves the rest of it unread.
+	Status Next(Record& record);
+
+	uint32_t GetVersion() const { return version; }
+	int64_t GetStartTime() const { return startTime; }
+	const std::vector<Definition>& GetDefinitions() const { return definitions; }
+
+private:
+	template <class T>
+	bool Read(T& value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+
+	template <class Length>
+	bool ReadString(std::string& string);
+
+	std::istream& stream;
+	uint32_t version = 0;
+	int64_t startTime = 0;
+	std::vector<Definition> definitions;
+};
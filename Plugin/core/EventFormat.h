@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Binary event log layout, shared by the plugin and tools/event_decode. All values are little endian.
+//
+// Header
+//   char[4]  magic "UFEL"
+//   u32      version
+//   i64      session start, microseconds since the Unix epoch
+//   u16      event count, then per event:
+//              u8 level, u8 name length, name, u8 argument count, one type per argument ('i' or 'f'),
+//              u16 format length, format
+// Records, until the end of the file
+//   u16      event
+//   u32      events suppressed by the rate limit since the previous record of this event
+//   i64      microseconds since the session start
+//   8 bytes  per argument, int64 or double as given by the event's types
+//
+// Formats use {} placeholders with an optional printf style spec such as {:X} or {:.2f}, so they can be
+// expanded without std::format by any tool that reads the header. A spec is flags out of "-+ #0", a width
+// and a precision of at most two digits each and one conversion valid for the argument: d i o u x X for
+// integers, f F e E g G a A for doubles. Formats come from files, a placeholder with any other spec is
+// copied into the text as it is and its argument skipped.
+namespace EventFormat
+{
+	constexpr char Magic[4] = { 'U', 'F', 'E', 'L' };
+	constexpr uint32_t Version = 1;
+
+	enum class Level : uint8_t
+	{
+		Debug,
+		Info,
+		Error
+	};
+
+	union Arg
+	{
+		int64_t i;
+		double f;
+	};
+
+	// Returns the printf format for one argument, or nothing if the spec is not allowed for its type.
+	inline std::optional<std::string> MakePrintfFormat(std::string_view spec, char type)
+	{
+		size_t i = 0;
+		while (i < spec.size() && std::string_view("-+ #0").find(spec[i]) != std::string_view::npos)
+			i++;
+
+		const auto skipDigits = [&] {
+			const auto start = i;
+			while (i < spec.size() && spec[i] >= '0' && spec[i] <= '9')
+				i++;
+			return i - start <= 2;
+		};
+		if (!skipDigits())
+			return std::nullopt;
+		if (i < spec.size() && spec[i] == '.') {
+			i++;
+			if (!skipDigits())
+				return std::nullopt;
+		}
+		if (spec.size() - i > 1)
+			return std::nullopt;
+
+		std::string printfFormat = "%";
+		printfFormat.append(spec.substr(0, i));
+		const char conversion = i < spec.size() ? spec[i] : (type == 'i' ? 'd' : 'g');
+		if (type == 'i' && std::string_view("diouxX").find(conversion) != std::string_view::npos)
+			printfFormat.append("ll") += conversion;
+		else if (type == 'f' && std::string_view("fFeEgGaA").find(conversion) != std::string_view::npos)
+			printfFormat += conversion;
+		else
+			return std::nullopt;
+		return printfFormat;
+	}
+
+	inline std::string Format(std::string_view format, std::string_view types, const Arg* args)
+	{
+		std::string text;
+		size_t arg = 0;
+
+		for (size_t i = 0; i < format.size(); i++) {
+			if (format[i] == '}' && i + 1 < format.size() && format[i + 1] == '}')
+				i++;
+			if (format[i] != '{' || i + 1 == format.size()) {
+				text += format[i];
+				continue;
+			}
+			if (format[i + 1] == '{') {
+				text += '{';
+				i++;
+				continue;
+			}
+
+			const auto end = format.find('}', i);
+			if (end == std::string_view::npos || arg >= types.size()) {
+				text += format.substr(i);
+				break;
+			}
+
+			auto spec = format.substr(i + 1, end - i - 1);
+			if (!spec.empty() && spec.front() == ':')
+				spec.remove_prefix(1);
+
+			const auto printfFormat = MakePrintfFormat(spec, types[arg]);
+			if (!printfFormat) {
+				text += format.substr(i, end - i + 1);
+			} else {
+				char buffer[64];
+				const int length = types[arg] == 'i' ? std::snprintf(buffer, sizeof(buffer), printfFormat->c_str(), static_cast<long long>(args[arg].i)) : std::snprintf(buffer, sizeof(buffer), printfFormat->c_str(), args[arg].f);
+				if (length > 0)
+					text.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+			}
+
+			arg++;
+			i = end;
+		}
+
+		return text;
+	}
+}
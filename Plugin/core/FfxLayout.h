@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ffx_fsr2.h"
+
+#include <cstddef>
+#include <optional>
+
+// The FSR2 SDK is statically linked into the game, so the descriptions we are handed follow the SDK version
+// the game was built with, not ffx_fsr2.h. Of the fields read here only one layout change exists: 2.1 added
+// preExposure in front of reset, 2.2 only appended fields. Each layout is mirrored below with its offsets
+// asserted, the hooks pick one when they are installed and go through Dispatch<V> from then on.
+namespace FfxLayout
+{
+	enum class Version : uint8_t
+	{
+		Fsr20,
+		Fsr22  // also 2.1
+	};
+
+	struct DispatchDescription20
+	{
+		FfxCommandList commandList;
+		FfxResource color;
+		FfxResource depth;
+		FfxResource motionVectors;
+		FfxResource exposure;
+		FfxResource reactive;
+		FfxResource transparencyAndComposition;
+		FfxResource output;
+		FfxFloatCoords2D jitterOffset;
+		FfxFloatCoords2D motionVectorScale;
+		FfxDimensions2D renderSize;
+		bool enableSharpening;
+		float sharpness;
+		float frameTimeDelta;
+		bool reset;
+		float cameraNear;
+		float cameraFar;
+		float cameraFovAngleVertical;
+	};
+
+	template <Version V>
+	struct Traits;
+
+	template <>
+	struct Traits<Version::Fsr20>
+	{
+		using Description = DispatchDescription20;
+	};
+
+	template <>
+	struct Traits<Version::Fsr22>
+	{
+		using Description = FfxFsr2DispatchDescription;
+	};
+
+	// What the plugin reads from a dispatch, copied out so nothing past the hook depends on the layout
+	struct DispatchFields
+	{
+		FfxDimensions2D renderSize;
+		FfxFloatCoords2D jitterOffset;
+		float sharpness;
+		float frameTimeDelta;
+		float cameraNear;
+		float cameraFar;
+		float cameraFovAngleVertical;
+		bool enableSharpening;
+		bool reset;
+	};
+
+	template <Version V>
+	struct Dispatch
+	{
+		using Description = typename Traits<V>::Description;
+
+		// Distance between the renderSize and reset stores the game makes right before the dispatch call
+		static constexpr ptrdiff_t ResetDistance = ptrdiff_t(offsetof(Description, reset)) - ptrdiff_t(offsetof(Description, renderSize));
+
+		static DispatchFields Read(const void* params)
+		{
+			const auto description = static_cast<const Description*>(params);
+			return { description->renderSize, description->jitterOffset, description->sharpness, description->frameTimeDelta,
+				description->cameraNear, description->cameraFar, description->cameraFovAngleVertical, description->enableSharpening, description->reset };
+		}
+
+		static void SetReset(void* params) { static_cast<Description*>(params)->reset = true; }
+	};
+
+	constexpr std::optional<Version> FromResetDistance(ptrdiff_t distance)
+	{
+		if (distance == Dispatch<Version::Fsr20>::ResetDistance)
+			return Version::Fsr20;
+		if (distance == Dispatch<Version::Fsr22>::ResetDistance)
+			return Version::Fsr22;
+		return std::nullopt;
+	}
+
+	// Everything up to renderSize is shared, the distances tell the layouts apart
+	static_assert(offsetof(DispatchDescription20, renderSize) == offsetof(FfxFsr2DispatchDescription, renderSize));
+	static_assert(offsetof(DispatchDescription20, jitterOffset) == offsetof(FfxFsr2DispatchDescription, jitterOffset));
+	static_assert(Dispatch<Version::Fsr20>::ResetDistance == 20);
+	static_assert(Dispatch<Version::Fsr22>::ResetDistance == 24);
+	static_assert(offsetof(FfxFsr2DispatchDescription, cameraFovAngleVertical) - offsetof(FfxFsr2DispatchDescription, reset) ==
+				  offsetof(DispatchDescription20, cameraFovAngleVertical) - offsetof(DispatchDescription20, reset));
+
+#if defined(_WIN64)
+	// Absolute offsets only hold with the Windows wchar_t inside FfxResource
+	static_assert(sizeof(FfxResource) == 184);
+
+	static_assert(offsetof(FfxFsr2DispatchDescription, renderSize) == 1312);
+	static_assert(offsetof(FfxFsr2DispatchDescription, reset) == 1336);
+	static_assert(offsetof(FfxFsr2DispatchDescription, cameraFovAngleVertical) == 1348);
+	static_assert(sizeof(FfxFsr2DispatchDescription) == 1560);
+
+	static_assert(offsetof(DispatchDescription20, reset) == 1332);
+	static_assert(offsetof(DispatchDescription20, cameraFovAngleVertical) == 1344);
+	static_assert(sizeof(DispatchDescription20) == 1352);
+
+	// ContextPool and FfxUtil::GetInterface read these from game memory as well
+	static_assert(sizeof(FfxFsr2Interface) == 112);
+	static_assert(offsetof(FfxFsr2ContextDescription, displaySize) == 12);
+	static_assert(offsetof(FfxFsr2ContextDescription, callbacks) == 24);
+	static_assert(sizeof(FfxFsr2ContextDescription) == 152);
+#endif
+}
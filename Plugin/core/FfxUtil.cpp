@@ -0,0 +1,100 @@
+#include "FfxUtil.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+
+namespace FfxUtil
+{
+	size_t GetFormatSize(FfxSurfaceFormat format)
+	{
+		switch (format) {
+		case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+		case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+			return 16;
+		case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+		case FFX_SURFACE_FORMAT_R16G16B16A16_UNORM:
+		case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+			return 8;
+		case FFX_SURFACE_FORMAT_R32_UINT:
+		case FFX_SURFACE_FORMAT_R8G8B8A8_TYPELESS:
+		case FFX_SURFACE_FORMAT_R8G8B8A8_UNORM:
+		case FFX_SURFACE_FORMAT_R11G11B10_FLOAT:
+		case FFX_SURFACE_FORMAT_R16G16_FLOAT:
+		case FFX_SURFACE_FORMAT_R16G16_UINT:
+		case FFX_SURFACE_FORMAT_R32_FLOAT:
+			return 4;
+		case FFX_SURFACE_FORMAT_R16_FLOAT:
+		case FFX_SURFACE_FORMAT_R16_UINT:
+		case FFX_SURFACE_FORMAT_R16_UNORM:
+		case FFX_SURFACE_FORMAT_R16_SNORM:
+		case FFX_SURFACE_FORMAT_R8G8_UNORM:
+			return 2;
+		case FFX_SURFACE_FORMAT_R8_UNORM:
+		case FFX_SURFACE_FORMAT_R8_UINT:
+			return 1;
+		default:
+			return 4;
+		}
+	}
+
+	size_t EstimateResourceSize(const FfxResourceDescription& desc)
+	{
+		if (desc.type == FFX_RESOURCE_TYPE_BUFFER)
+			return desc.width;
+
+		size_t width = std::max(desc.width, 1u);
+		size_t height = std::max(desc.height, 1u);
+		const size_t depth = std::max(desc.depth, 1u);
+		const size_t texelSize = GetFormatSize(desc.format);
+
+		size_t bytes = 0;
+		for (uint32_t mip = 0; desc.mipCount == 0 || mip < desc.mipCount; mip++) {
+			bytes += width * height * depth * texelSize;
+			if (width == 1 && height == 1)
+				break;
+			width = std::max(width / 2, size_t(1));
+			height = std::max(height / 2, size_t(1));
+		}
+		return bytes;
+	}
+
+	FfxFsr2Interface* GetInterface(FfxFsr2Context* context)
+	{
+		// The SDK keeps its copy of the context description at the start of the context memory
+		return reinterpret_cast<FfxFsr2Interface*>(reinterpret_cast<uint8_t*>(context) + offsetof(FfxFsr2ContextDescription, callbacks));
+	}
+
+	bool IsValidSize(FfxDimensions2D size)
+	{
+		return size.width && size.height && size.width <= MaxDimension && size.height <= MaxDimension;
+	}
+
+	bool IsValidContext(const FfxFsr2ContextDescription& desc)
+	{
+		return IsValidSize(desc.displaySize) && IsValidSize(desc.maxRenderSize);
+	}
+
+	DispatchError ValidateDispatch(const FfxLayout::DispatchFields& dispatch, FfxDimensions2D displaySize)
+	{
+		if (!IsValidSize(dispatch.renderSize))
+			return DispatchError::RenderSize;
+		if (IsValidSize(displaySize) && (dispatch.renderSize.width > displaySize.width || dispatch.renderSize.height > displaySize.height))
+			return DispatchError::RenderSize;
+
+		// Jitter is a subpixel offset; denormals are rejected too, they are never intentional and slow
+		// down every float operation they reach on the way to effect uniforms
+		for (const float offset : { dispatch.jitterOffset.x, dispatch.jitterOffset.y }) {
+			if (!std::isfinite(offset) || std::abs(offset) > 1.0f || (offset != 0.0f && std::abs(offset) < FLT_MIN))
+				return DispatchError::Jitter;
+		}
+
+		if (!std::isfinite(dispatch.frameTimeDelta) || dispatch.frameTimeDelta < 0.0f)
+			return DispatchError::FrameTime;
+		if (!std::isfinite(dispatch.sharpness))
+			return DispatchError::Sharpness;
+
+		return DispatchError::None;
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "FfxLayout.h"
+#include "ffx_fsr2.h"
+
+#include <cstddef>
+
+// Helpers for FSR2 SDK structures that do not need a device or a running SDK.
+namespace FfxUtil
+{
+	size_t GetFormatSize(FfxSurfaceFormat format);
+
+	// Approximate video memory used by a resource, good enough to budget the context pool.
+	size_t EstimateResourceSize(const FfxResourceDescription& desc);
+
+	// The SDK keeps the backend interface inside the context memory; this is where.
+	FfxFsr2Interface* GetInterface(FfxFsr2Context* context);
+
+	// Descriptions come straight from game memory. These checks run before any of their values reach the
+	// per-frame logic, so a garbage description is skipped instead of producing NaN biases, denormal
+	// uniforms or sizes that make later loops and allocations explode.
+	constexpr uint32_t MaxDimension = 16384;
+
+	enum class DispatchError : uint8_t
+	{
+		None,
+		RenderSize,
+		Jitter,
+		FrameTime,
+		Sharpness
+	};
+
+	bool IsValidSize(FfxDimensions2D size);
+	bool IsValidContext(const FfxFsr2ContextDescription& desc);
+
+	// displaySize may be unknown (zero), in which case the render size is only checked on its own.
+	DispatchError ValidateDispatch(const FfxLayout::DispatchFields& dispatch, FfxDimensions2D displaySize);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only void() callable stored inline in Capacity bytes, so posting a job never allocates. A callable
+// that does not fit fails to compile; move large state behind a unique_ptr first. Moving leaves the
+// source empty, which lets a ring slot release its captures as soon as the job is popped.
+template <size_t Capacity>
+class InplaceFunction
+{
+public:
+	InplaceFunction() = default;
+	InplaceFunction(std::nullptr_t) {}
+
+	template <class F>
+		requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> && std::is_invocable_r_v<void, std::decay_t<F>&>)
+	InplaceFunction(F&& function)
+	{
+		using T = std::decay_t<F>;
+		static_assert(sizeof(T) <= Capacity, "callable does not fit, move its state behind a unique_ptr");
+		static_assert(alignof(T) <= alignof(std::max_align_t));
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+
+		::new (static_cast<void*>(storage)) T(std::forward<F>(function));
+		ops = &Ops<T>::Table;
+	}
+
+	InplaceFunction(InplaceFunction&& other) noexcept { MoveFrom(other); }
+
+	InplaceFunction& operator=(InplaceFunction&& other) noexcept
+	{
+		if (this != &other) {
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	InplaceFunction& operator=(std::nullptr_t)
+	{
+		Reset();
+		return *this;
+	}
+
+	~InplaceFunction() { Reset(); }
+
+	explicit operator bool() const { return ops != nullptr; }
+	void operator()() { ops->invoke(storage); }
+
+private:
+	struct OpsTable
+	{
+		void (*invoke)(void* target);
+		void (*move)(void* to, void* from);  // also destroys from
+		void (*destroy)(void* target);
+	};
+
+	template <class T>
+	struct Ops
+	{
+		static constexpr OpsTable Table{
+			[](void* target) { (*static_cast<T*>(target))(); },
+			[](void* to, void* from) {
+				::new (to) T(std::move(*static_cast<T*>(from)));
+				static_cast<T*>(from)->~T();
+			},
+			[](void* target) { static_cast<T*>(target)->~T(); }
+		};
+	};
+
+	void MoveFrom(InplaceFunction& other)
+	{
+		if (!other.ops)
+			return;
+		other.ops->move(storage, other.storage);
+		ops = std::exchange(other.ops, nullptr);
+	}
+
+	void Reset()
+	{
+		if (ops)
+			std::exchange(ops, nullptr)->destroy(storage);
+	}
+
+	alignas(std::max_align_t) std::byte storage[Capacity];
+	const OpsTable* ops = nullptr;
+};
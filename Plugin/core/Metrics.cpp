@@ -0,0 +1,73 @@
+#include "Metrics.h"
+
+#include <algorithm>
+
+namespace Metrics
+{
+	namespace
+	{
+		// Constant initialized, so metrics constructed in other translation units can link in at any point
+		// of static initialization
+		constinit Metric* first = nullptr;
+		constinit Metric** last = &first;
+
+		std::atomic<size_t> nextShard = 0;
+	}
+
+	size_t GetShard()
+	{
+		thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % Shards;
+		return shard;
+	}
+
+	Metric::Metric(Kind kind, const char* name, const char* unit) :
+		kind(kind), name(name), unit(unit)
+	{
+		*last = this;
+		last = &next;
+	}
+
+	const Metric* GetFirst()
+	{
+		return first;
+	}
+
+	uint64_t Counter::Get() const
+	{
+		uint64_t total = 0;
+		for (const auto& shard : shards)
+			total += shard.value.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	Histogram::Histogram(const char* name, const char* unit, const double* newBounds, size_t count) :
+		Metric(Kind::Histogram, name, unit)
+	{
+		std::copy_n(newBounds, count, bounds.begin());
+		buckets = count + 1;
+	}
+
+	void Histogram::Record(double sample)
+	{
+		size_t bucket = 0;
+		while (bucket < buckets - 1 && sample > bounds[bucket])
+			bucket++;
+
+		auto& shard = shards[GetShard()];
+		shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+		shard.count.fetch_add(1, std::memory_order_relaxed);
+		shard.sum.fetch_add(sample, std::memory_order_relaxed);
+	}
+
+	Histogram::Snapshot Histogram::Get() const
+	{
+		Snapshot snapshot;
+		for (const auto& shard : shards) {
+			for (size_t i = 0; i < buckets; i++)
+				snapshot.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+			snapshot.count += shard.count.load(std::memory_order_relaxed);
+			snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+		}
+		return snapshot;
+	}
+}
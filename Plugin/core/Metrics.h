@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Plugin-wide counters, gauges and histograms. A metric is a namespace scope object that links itself into
+// the registry when it is constructed, so defining one next to the code it measures is all it takes for it
+// to show up in the overlay and the metrics file. Counters and histograms are sharded per thread: a thread
+// picks a shard on first use and only does relaxed increments there, readers sum the shards. Threads past
+// Shards share one, which stays correct and only costs contention. Gauges keep one value, the last write wins.
+namespace Metrics
+{
+	constexpr size_t Shards = 8;
+
+	size_t GetShard();
+
+	enum class Kind : uint8_t
+	{
+		Counter,
+		Gauge,
+		Histogram
+	};
+
+	class Metric
+	{
+	public:
+		Metric(const Metric&) = delete;
+		Metric& operator=(const Metric&) = delete;
+
+		Kind GetKind() const { return kind; }
+		const char* GetName() const { return name; }
+		const char* GetUnit() const { return unit; }
+		const Metric* GetNext() const { return next; }
+
+	protected:
+		Metric(Kind kind, const char* name, const char* unit);
+
+	private:
+		Kind kind;
+		const char* name;
+		const char* unit;
+		Metric* next = nullptr;
+	};
+
+	// Registration happens during static initialization, the list is not modified afterwards.
+	const Metric* GetFirst();
+
+	template <class Fn>
+	void ForEach(Fn&& fn)
+	{
+		for (auto metric = GetFirst(); metric; metric = metric->GetNext())
+			fn(*metric);
+	}
+
+	class Counter : public Metric
+	{
+	public:
+		explicit Counter(const char* name, const char* unit = "") :
+			Metric(Kind::Counter, name, unit) {}
+
+		void Add(uint64_t value = 1) { shards[GetShard()].value.fetch_add(value, std::memory_order_relaxed); }
+		uint64_t Get() const;
+
+	private:
+		struct alignas(64) Shard
+		{
+			std::atomic<uint64_t> value = 0;
+		};
+
+		std::array<Shard, Shards> shards;
+	};
+
+	class Gauge : public Metric
+	{
+	public:
+		explicit Gauge(const char* name, const char* unit = "") :
+			Metric(Kind::Gauge, name, unit) {}
+
+		void Set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+		double Get() const { return value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<double> value = 0.0;
+	};
+
+	// Bucket i counts samples <= bound i, the last bucket everything above the last bound.
+	class Histogram : public Metric
+	{
+	public:
+		static constexpr size_t MaxBuckets = 16;
+
+		struct Snapshot
+		{
+			std::array<uint64_t, MaxBuckets> counts{};
+			uint64_t count = 0;
+			double sum = 0.0;
+
+			double Mean() const { return count ? sum / double(count) : 0.0; }
+		};
+
+		// Between 1 and MaxBuckets - 1 ascending bounds, checked at compile time.
+		template <size_t N>
+		Histogram(const char* name, const char* unit, const double (&bounds)[N]) :
+			Histogram(name, unit, bounds, N)
+		{
+			static_assert(N >= 1 && N < MaxBuckets, "a histogram takes between 1 and MaxBuckets - 1 bounds");
+		}
+
+		void Record(double sample);
+		Snapshot Get() const;
+
+		size_t GetBuckets() const { return buckets; }
+		double GetBound(size_t bucket) const { return bounds[bucket]; }
+
+	private:
+		Histogram(const char* name, const char* unit, const double* bounds, size_t count);
+
+		struct alignas(64) Shard
+		{
+			std::array<std::atomic<uint64_t>, MaxBuckets> counts{};
+			std::atomic<uint64_t> count = 0;
+			std::atomic<double> sum = 0.0;
+		};
+
+		std::array<double, MaxBuckets - 1> bounds{};
+		size_t buckets = 0;
+		std::array<Shard, Shards> shards;
+	};
+}
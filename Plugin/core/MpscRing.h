@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity lock-free queue for any number of producer threads and exactly one consumer thread.
+// Each slot carries a sequence number so producers only contend on claiming the head, never on the data.
+template <class T, size_t N>
+class MpscRing
+{
+public:
+	static_assert(N && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+	MpscRing()
+	{
+		for (size_t i = 0; i < N; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	bool Push(const T& value)
+	{
+		auto head = this->head.load(std::memory_order_relaxed);
+		while (true) {
+			auto& cell = cells[head & (N - 1)];
+			const auto sequence = cell.sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head);
+			if (difference == 0) {
+				if (this->head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+					cell.value = value;
+					cell.sequence.store(head + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (difference < 0) {
+				return false;  // full
+			} else {
+				head = this->head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool Pop(T& value)
+	{
+		auto& cell = cells[tail & (N - 1)];
+		if (cell.sequence.load(std::memory_order_acquire) != tail + 1)
+			return false;
+
+		value = cell.value;
+		cell.sequence.store(tail + N, std::memory_order_release);
+		tail++;
+		return true;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::array<Cell, N> cells;
+	alignas(64) std::atomic<size_t> head = 0;
+	alignas(64) size_t tail = 0;  // consumer only
+};
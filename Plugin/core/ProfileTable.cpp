@@ -0,0 +1,106 @@
+#include "ProfileTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace
+{
+	uint64_t PairKey(uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth, uint32_t displayHeight)
+	{
+		return uint64_t(renderWidth & 0xFFFF) << 48 | uint64_t(renderHeight & 0xFFFF) << 32 | uint64_t(displayWidth & 0xFFFF) << 16 | uint64_t(displayHeight & 0xFFFF);
+	}
+
+	size_t PairSlot(uint64_t key, uint32_t shift)
+	{
+		// Fibonacci hashing, the top bits of the product spread neighbouring resolutions well
+		return size_t((key * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+	size_t RatioBucket(float ratio)
+	{
+		return size_t(std::clamp(ratio, 0.0f, 1.0f) * (ProfileTable::RatioBuckets - 1) + 0.5f);
+	}
+}
+
+bool ProfileTable::AddScale(std::string name, float biasOffset, float scale, float tolerance)
+{
+	if (!std::isfinite(scale) || !std::isfinite(tolerance) || tolerance < 0.0f)
+		return false;
+
+	profiles.push_back({ std::move(name), biasOffset });
+	const auto index = static_cast<uint16_t>(profiles.size());
+
+	for (auto bucket = RatioBucket(scale - tolerance); bucket <= RatioBucket(scale + tolerance); bucket++) {
+		if (!ratioProfiles[bucket])
+			ratioProfiles[bucket] = index;
+	}
+	return true;
+}
+
+bool ProfileTable::AddPair(std::string name, float biasOffset, uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth, uint32_t displayHeight)
+{
+	// Wider values would alias another pair in the key
+	if (std::max({ renderWidth, renderHeight, displayWidth, displayHeight }) > MaxDimension)
+		return false;
+
+	const auto key = PairKey(renderWidth, renderHeight, displayWidth, displayHeight);
+	if (std::ranges::find(pairs, key, &std::pair<uint64_t, uint16_t>::first) != pairs.end())
+		return false;
+
+	profiles.push_back({ std::move(name), biasOffset });
+	pairs.emplace_back(key, static_cast<uint16_t>(profiles.size()));
+	return true;
+}
+
+bool ProfileTable::Compile()
+{
+	if (profiles.size() > MaxProfiles)
+		return false;
+	if (pairs.empty())
+		return true;
+
+	// Grows the table until every key has its own slot, so lookups never probe
+	for (auto bits = static_cast<uint32_t>(std::bit_width(pairs.size())); bits <= 16; bits++) {
+		const uint32_t shift = 64 - bits;
+		std::vector<uint64_t> keys(size_t(1) << bits);
+		std::vector<uint16_t> indices(keys.size());
+
+		bool collided = false;
+		for (const auto& [key, profile] : pairs) {
+			const auto slot = PairSlot(key, shift);
+			if (keys[slot]) {
+				collided = true;
+				break;
+			}
+			keys[slot] = key;
+			indices[slot] = profile;
+		}
+
+		if (!collided) {
+			pairKeys = std::move(keys);
+			pairProfiles = std::move(indices);
+			pairShift = shift;
+			pairs.clear();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const ProfileTable::Profile* ProfileTable::Find(uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth, uint32_t displayHeight) const
+{
+	if (!displayWidth)
+		return nullptr;
+
+	if (!pairKeys.empty()) {
+		const auto key = PairKey(renderWidth, renderHeight, displayWidth, displayHeight);
+		const auto slot = PairSlot(key, pairShift);
+		if (pairKeys[slot] == key)
+			return &profiles[pairProfiles[slot] - 1];
+	}
+
+	const auto profile = ratioProfiles[RatioBucket(float(renderWidth) / float(displayWidth))];
+	return profile ? &profiles[profile - 1] : nullptr;
+}
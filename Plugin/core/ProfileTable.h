@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Extra bias offsets per quality preset, matched by exact (render, display) resolution pair first and by
+// render scale otherwise. Compiled once after all profiles were added, so Find is two array reads with no
+// strings or maps: resolution pairs go into a collision free hash table, scales into a direct index over
+// the quantized render / display width ratio.
+class ProfileTable
+{
+public:
+	struct Profile
+	{
+		std::string name;
+		float biasOffset;
+	};
+
+	static constexpr size_t RatioBuckets = 256;
+	static constexpr size_t MaxProfiles = UINT16_MAX - 1;
+	static constexpr uint32_t MaxDimension = UINT16_MAX;  // pairs are keyed on 16 bits per dimension
+
+	// Matches render width / display width within tolerance. Earlier profiles keep the scales they cover.
+	// Returns false for a non-finite scale or tolerance.
+	bool AddScale(std::string name, float biasOffset, float scale, float tolerance);
+
+	// Returns false if a dimension is above MaxDimension or an earlier profile has the same resolutions.
+	bool AddPair(std::string name, float biasOffset, uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth, uint32_t displayHeight);
+
+	bool Compile();
+
+	const Profile* Find(uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth, uint32_t displayHeight) const;
+
+	const std::vector<Profile>& GetProfiles() const { return profiles; }
+
+private:
+	std::vector<Profile> profiles;
+	std::vector<std::pair<uint64_t, uint16_t>> pairs;  // until Compile
+
+	// Values are profile index + 1, 0 for none
+	std::vector<uint64_t> pairKeys;
+	std::vector<uint16_t> pairProfiles;
+	uint32_t pairShift = 63;
+	std::array<uint16_t, RatioBuckets> ratioProfiles{};
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+// Minimal encoder and decoder for the QOI image format (https://qoiformat.org), RGBA8 only.
+// Header-only and free of platform dependencies, so the capture analysis tool can share it.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Qoi
+{
+	namespace detail
+	{
+		enum : uint8_t
+		{
+			OpIndex = 0x00,
+			OpDiff = 0x40,
+			OpLuma = 0x80,
+			OpRun = 0xC0,
+			OpRgb = 0xFE,
+			OpRgba = 0xFF,
+			Mask = 0xC0
+		};
+
+		struct Pixel
+		{
+			uint8_t r, g, b, a;
+
+			bool operator==(const Pixel& other) const { return r == other.r && g == other.g && b == other.b && a == other.a; }
+			size_t Hash() const { return (r * 3 + g * 5 + b * 7 + a * 11) % 64; }
+		};
+
+		constexpr uint8_t Padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+		inline void Write32(std::vector<uint8_t>& out, uint32_t value)
+		{
+			out.push_back(uint8_t(value >> 24));
+			out.push_back(uint8_t(value >> 16));
+			out.push_back(uint8_t(value >> 8));
+			out.push_back(uint8_t(value));
+		}
+
+		inline uint32_t Read32(const uint8_t* data)
+		{
+			return uint32_t(data[0]) << 24 | uint32_t(data[1]) << 16 | uint32_t(data[2]) << 8 | data[3];
+		}
+	}
+
+	inline std::vector<uint8_t> Encode(const uint8_t* rgba, uint32_t width, uint32_t height)
+	{
+		using namespace detail;
+
+		std::vector<uint8_t> out;
+		out.reserve(14 + size_t(width) * height * 5 / 2 + sizeof(Padding));
+
+		out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+		Write32(out, width);
+		Write32(out, height);
+		out.push_back(4);  // channels
+		out.push_back(0);  // sRGB with linear alpha
+
+		Pixel index[64]{};
+		Pixel previous{ 0, 0, 0, 255 };
+		uint32_t run = 0;
+
+		const size_t count = size_t(width) * height;
+		for (size_t i = 0; i < count; i++) {
+			Pixel pixel;
+			std::memcpy(&pixel, rgba + i * 4, 4);
+
+			if (pixel == previous) {
+				if (++run == 62 || i + 1 == count) {
+					out.push_back(uint8_t(OpRun | (run - 1)));
+					run = 0;
+				}
+				continue;
+			}
+
+			if (run) {
+				out.push_back(uint8_t(OpRun | (run - 1)));
+				run = 0;
+			}
+
+			const auto hash = pixel.Hash();
+			if (index[hash] == pixel) {
+				out.push_back(uint8_t(OpIndex | hash));
+			} else {
+				index[hash] = pixel;
+
+				if (pixel.a == previous.a) {
+					const int8_t dr = int8_t(pixel.r - previous.r);
+					const int8_t dg = int8_t(pixel.g - previous.g);
+					const int8_t db = int8_t(pixel.b - previous.b);
+					const int8_t drdg = int8_t(dr - dg);
+					const int8_t dbdg = int8_t(db - dg);
+
+					if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+						out.push_back(uint8_t(OpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					} else if (dg >= -32 && dg <= 31 && drdg >= -8 && drdg <= 7 && dbdg >= -8 && dbdg <= 7) {
+						out.push_back(uint8_t(OpLuma | (dg + 32)));
+						out.push_back(uint8_t((drdg + 8) << 4 | (dbdg + 8)));
+					} else {
+						out.insert(out.end(), { OpRgb, pixel.r, pixel.g, pixel.b });
+					}
+				} else {
+					out.insert(out.end(), { OpRgba, pixel.r, pixel.g, pixel.b, pixel.a });
+				}
+			}
+
+			previous = pixel;
+		}
+
+		out.insert(out.end(), std::begin(Padding), std::end(Padding));
+		return out;
+	}
+
+	// Returns false if the data is not a valid 3 or 4 channel QOI image. Pixels are always returned as RGBA.
+	inline bool Decode(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba, uint32_t& width, uint32_t& height)
+	{
+		using namespace detail;
+
+		if (size < 14 + sizeof(Padding) || std::memcmp(data, "qoif", 4) != 0)
+			return false;
+
+		width = Read32(data + 4);
+		height = Read32(data + 8);
+		if (!width || !height || size_t(width) * height > (size_t(1) << 28))
+			return false;
+
+		const size_t count = size_t(width) * height;
+		rgba.resize(count * 4);
+
+		Pixel index[64]{};
+		Pixel pixel{ 0, 0, 0, 255 };
+		size_t position = 14;
+		const size_t end = size - sizeof(Padding);
+		uint32_t run = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			if (run) {
+				run--;
+			} else if (position < end) {
+				const uint8_t op = data[position++];
+
+				if (op == OpRgb) {
+					if (end - position < 3)
+						return false;
+					pixel.r = data[position++];
+					pixel.g = data[position++];
+					pixel.b = data[position++];
+				} else if (op == OpRgba) {
+					if (end - position < 4)
+						return false;
+					pixel.r = data[position++];
+					pixel.g = data[position++];
+					pixel.b = data[position++];
+					pixel.a = data[position++];
+				} else if ((op & Mask) == OpIndex) {
+					pixel = index[op];
+				} else if ((op & Mask) == OpDiff) {
+					pixel.r = static_cast<uint8_t>(pixel.r + ((op >> 4) & 3) - 2);
+					pixel.g = static_cast<uint8_t>(pixel.g + ((op >> 2) & 3) - 2);
+					pixel.b = static_cast<uint8_t>(pixel.b + (op & 3) - 2);
+				} else if ((op & Mask) == OpLuma) {
+					if (end - position < 1)
+						return false;
+					const uint8_t next = data[position++];
+					const int dg = (op & 0x3F) - 32;
+					pixel.r = static_cast<uint8_t>(pixel.r + dg - 8 + ((next >> 4) & 0xF));
+					pixel.g = static_cast<uint8_t>(pixel.g + dg);
+					pixel.b = static_cast<uint8_t>(pixel.b + dg - 8 + (next & 0xF));
+				} else {
+					run = op & 0x3F;
+				}
+
+				index[pixel.Hash()] = pixel;
+			} else {
+				return false;
+			}
+
+			std::memcpy(rgba.data() + i * 4, &pixel, 4);
+		}
+
+		return true;
+	}
+}
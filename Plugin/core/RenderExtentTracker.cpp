@@ -0,0 +1,93 @@
+#include "RenderExtentTracker.h"
+
+#include <cmath>
+
+void RenderExtentTracker::CountBind(uint32_t width, uint32_t height)
+{
+	const auto extent = Pack(width, height);
+	for (auto& bucket : histogram) {
+		auto current = bucket.extent.load(std::memory_order_relaxed);
+		if (!current && bucket.extent.compare_exchange_strong(current, extent, std::memory_order_relaxed))
+			current = extent;
+
+		if (current == extent) {
+			bucket.count.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	// More distinct extents than buckets in one frame, the rest are not interesting enough to track
+}
+
+uint32_t RenderExtentTracker::PickRenderExtent(FfxDimensions2D displaySize) const
+{
+	const float displayAspect = float(displaySize.width) / float(displaySize.height);
+
+	uint32_t best = 0;
+	uint32_t bestCount = MinBinds - 1;
+	for (auto& bucket : histogram) {
+		const auto extent = bucket.extent.load(std::memory_order_relaxed);
+		const auto count = bucket.count.load(std::memory_order_relaxed);
+		if (!extent || count <= bestCount)
+			continue;
+
+		const auto size = Unpack(extent);
+		if (!size.height || size.width > displaySize.width || size.height > displaySize.height)
+			continue;
+
+		const float aspect = float(size.width) / float(size.height);
+		if (std::abs(aspect - displayAspect) > displayAspect * 0.02f)
+			continue;
+
+		best = extent;
+		bestCount = count;
+	}
+
+	return best;
+}
+
+void RenderExtentTracker::EndFrame(FfxDimensions2D displaySize)
+{
+	const auto picked = displaySize.height ? PickRenderExtent(displaySize) : 0;
+
+	for (auto& bucket : histogram) {
+		bucket.count.store(0, std::memory_order_relaxed);
+		bucket.extent.store(0, std::memory_order_relaxed);
+	}
+
+	// A render size detected for another display size says nothing about this one
+	const auto newDisplay = Pack(displaySize.width, displaySize.height);
+	if (newDisplay != display) {
+		display = newDisplay;
+		candidate = 0;
+		candidateFrames = 0;
+		missedFrames = 0;
+		renderExtent.store(0, std::memory_order_relaxed);
+	}
+
+	if (picked && picked == candidate) {
+		candidateFrames++;
+	} else {
+		candidate = picked;
+		candidateFrames = picked ? 1 : 0;
+	}
+
+	const auto current = renderExtent.load(std::memory_order_relaxed);
+	if (candidateFrames >= StableFrames || (picked && picked == current)) {
+		renderExtent.store(picked, std::memory_order_relaxed);
+		missedFrames = 0;
+	} else if (current && ++missedFrames >= StableFrames) {
+		renderExtent.store(0, std::memory_order_relaxed);
+		missedFrames = 0;
+	}
+}
+
+bool RenderExtentTracker::GetRenderSize(FfxDimensions2D& renderSize) const
+{
+	const auto render = renderExtent.load(std::memory_order_relaxed);
+	if (!render)
+		return false;
+
+	renderSize = Unpack(render);
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ffx_fsr2.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// The render size half of resolution detection, without ReShade. Every depth-stencil bind is counted into
+// a small fixed histogram of extents, and at the end of the frame the most used extent with the display's
+// aspect ratio becomes the render size once it has won StableFrames frames in a row. Shadow maps and other
+// off-screen targets rarely share the display aspect ratio. The render size is dropped again when it has
+// not won for StableFrames frames, as in menus, loading screens or after a resolution change, and as soon
+// as the display size changes.
+//
+// CountBind runs thousands of times per frame from any recording thread, so counting is lock-free and
+// never allocates. EndFrame takes a single thread.
+class RenderExtentTracker
+{
+public:
+	static constexpr size_t Buckets = 16;
+	static constexpr uint32_t StableFrames = 8;
+	static constexpr uint32_t MinBinds = 4;
+
+	// Counts one depth-stencil bind at this extent. Lock-free and allocation-free.
+	void CountBind(uint32_t width, uint32_t height);
+
+	// Called once per presented frame. Picks this frame's render size and clears the histogram.
+	void EndFrame(FfxDimensions2D displaySize);
+
+	// Returns false while no render size is stable.
+	bool GetRenderSize(FfxDimensions2D& renderSize) const;
+
+private:
+	struct Bucket
+	{
+		std::atomic<uint32_t> extent = 0;
+		std::atomic<uint32_t> count = 0;
+	};
+
+	static constexpr uint32_t Pack(uint32_t width, uint32_t height) { return (std::min(width, 0xFFFFu) << 16) | std::min(height, 0xFFFFu); }
+	static constexpr FfxDimensions2D Unpack(uint32_t extent) { return { extent >> 16, extent & 0xFFFF }; }
+
+	uint32_t PickRenderExtent(FfxDimensions2D displaySize) const;
+
+	std::array<Bucket, Buckets> histogram;
+
+	// Only touched at the end of the frame
+	uint32_t display = 0;
+	uint32_t candidate = 0;
+	uint32_t candidateFrames = 0;
+	uint32_t missedFrames = 0;
+	std::atomic<uint32_t> renderExtent = 0;
+};
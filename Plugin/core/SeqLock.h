@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Sequence lock around a small trivially copyable value. Readers never block a writer, they copy the value
+// and retry if a write overlapped. Writers take turns through an odd sequence number, a writer only ever
+// waits for the handful of stores of another one, never for a reader. The value is kept in relaxed atomic
+// words so a torn read is a retry, not a data race.
+template <class T>
+class SeqLock
+{
+public:
+	static_assert(std::is_trivially_copyable_v<T>);
+
+	explicit SeqLock(const T& initial = T{}) { WriteWords(Pack(initial)); }
+
+	void Store(const T& value)
+	{
+		Update([&](T& current) { current = value; });
+	}
+
+	// Reads, modifies and writes the value as one write, for writers that each own part of it.
+	template <class Func>
+	void Update(Func&& func)
+	{
+		auto sequence = this->sequence.load(std::memory_order_relaxed);
+		for (;;) {
+			if (sequence & 1)
+				sequence = this->sequence.load(std::memory_order_relaxed);
+			else if (this->sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+				break;
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+
+		auto value = Unpack(ReadWords());
+		func(value);
+		WriteWords(Pack(value));
+
+		this->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	T Load() const
+	{
+		Words words;
+		for (;;) {
+			const auto before = sequence.load(std::memory_order_acquire);
+			if (before & 1)
+				continue;
+
+			words = ReadWords();
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (sequence.load(std::memory_order_relaxed) == before)
+				return Unpack(words);
+		}
+	}
+
+private:
+	static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	using Words = std::array<uint64_t, WordCount>;
+
+	static Words Pack(const T& value)
+	{
+		Words words{};
+		std::memcpy(words.data(), &value, sizeof(T));
+		return words;
+	}
+
+	static T Unpack(const Words& words)
+	{
+		T value;
+		std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+		return value;
+	}
+
+	Words ReadWords() const
+	{
+		Words words;
+		for (size_t i = 0; i < WordCount; i++)
+			words[i] = this->words[i].load(std::memory_order_relaxed);
+		return words;
+	}
+
+	void WriteWords(const Words& words)
+	{
+		for (size_t i = 0; i < WordCount; i++)
+			this->words[i].store(words[i], std::memory_order_relaxed);
+	}
+
+	std::atomic<uint64_t> sequence = 0;
+	std::array<std::atomic<uint64_t>, WordCount> words{};
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Publishes immutable snapshots to lock-free readers and frees replaced ones once no reader can still hold
+// them, with epoch based reclamation. A reader pins the current epoch in one of Readers slots for as long
+// as it holds its ReadGuard, which costs one CAS and two loads. Publish swaps the pointer and tags the
+// replaced snapshot with the epoch it was replaced in, then advances the epoch; Reclaim frees every tagged
+// snapshot no pinned slot is old enough to have seen. Guards nest, each takes a slot of its own. Should
+// more than Readers guards ever be alive at once, the extra ones pin nothing and reclamation stops for
+// good, replaced snapshots are then kept, never freed early. Publish and Reclaim take a single writer.
+template <class T, size_t Readers = 16>
+class SnapshotCell
+{
+public:
+	class ReadGuard
+	{
+	public:
+		ReadGuard(ReadGuard&& other) noexcept :
+			slot(std::exchange(other.slot, nullptr)), value(other.value) {}
+
+		ReadGuard(const ReadGuard&) = delete;
+		ReadGuard& operator=(const ReadGuard&) = delete;
+		ReadGuard& operator=(ReadGuard&&) = delete;
+
+		~ReadGuard()
+		{
+			if (slot)
+				slot->store(0, std::memory_order_release);
+		}
+
+		const T* get() const { return value; }
+		const T* operator->() const { return value; }
+		const T& operator*() const { return *value; }
+
+	private:
+		friend class SnapshotCell;
+
+		ReadGuard(std::atomic<uint64_t>* slot, const T* value) :
+			slot(slot), value(value) {}
+
+		std::atomic<uint64_t>* slot;
+		const T* value;
+	};
+
+	// initial is not owned and must outlive the cell.
+	explicit SnapshotCell(const T* initial) :
+		current(initial) {}
+
+	ReadGuard Read()
+	{
+		// Threads start their search in different places so they rarely contend for a slot
+		static std::atomic<size_t> nextStart = 0;
+		thread_local const size_t start = nextStart.fetch_add(1, std::memory_order_relaxed);
+
+		// Every step is sequentially consistent: a writer that saw this slot empty after replacing a
+		// snapshot guarantees the load below returns the replacement
+		const auto pin = epoch.load();
+		for (size_t i = 0; i < Readers; i++) {
+			auto& slot = slots[(start + i) % Readers].pinned;
+			uint64_t expected = 0;
+			if (slot.compare_exchange_strong(expected, pin))
+				return { &slot, current.load() };
+		}
+
+		overflow.store(true);
+		return { nullptr, current.load() };
+	}
+
+	// Returns the published snapshot, valid on the writer's thread until it publishes again.
+	const T* Publish(std::unique_ptr<T> snapshot)
+	{
+		auto replaced = std::exchange(latest, std::move(snapshot));
+		current.store(latest.get());
+		const auto replacedIn = epoch.fetch_add(1);
+		if (replaced)
+			retired.push_back({ std::move(replaced), replacedIn });
+		return latest.get();
+	}
+
+	// Frees the replaced snapshots no reader can hold anymore, returns how many are still retired.
+	size_t Reclaim()
+	{
+		if (overflow.load())
+			return retired.size();
+
+		// A slot pinned at the epoch a snapshot was replaced in, or earlier, may have loaded it
+		auto oldestPin = UINT64_MAX;
+		for (const auto& slot : slots) {
+			const auto pinned = slot.pinned.load();
+			if (pinned)
+				oldestPin = std::min(oldestPin, pinned);
+		}
+
+		std::erase_if(retired, [&](const Retired& entry) { return entry.replacedIn < oldestPin; });
+		return retired.size();
+	}
+
+	bool Overflowed() const { return overflow.load(std::memory_order_relaxed); }
+
+private:
+	struct alignas(64) Slot
+	{
+		std::atomic<uint64_t> pinned = 0;  // epoch when pinned, 0 when free
+	};
+
+	struct Retired
+	{
+		std::unique_ptr<T> snapshot;
+		uint64_t replacedIn;
+	};
+
+	std::atomic<const T*> current;
+	alignas(64) std::atomic<uint64_t> epoch = 1;
+	std::atomic<bool> overflow = false;
+	std::array<Slot, Readers> slots;
+
+	// Writer only
+	std::unique_ptr<T> latest;
+	std::vector<Retired> retired;
+};
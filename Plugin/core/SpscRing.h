@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Fixed-capacity lock-free queue for exactly one producer thread and one consumer thread.
+// Push fails instead of blocking or allocating when the consumer falls behind.
+template <class T, size_t N>
+class SpscRing
+{
+public:
+	static_assert(N && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+	bool Push(const T& value) { return Emplace(value); }
+	bool Push(T&& value) { return Emplace(std::move(value)); }
+
+	bool Pop(T& value)
+	{
+		const auto tail = this->tail.load(std::memory_order_relaxed);
+		if (tail == head.load(std::memory_order_acquire))
+			return false;
+
+		value = std::move(items[tail & (N - 1)]);
+		this->tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Empty() const { return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire); }
+
+private:
+	template <class U>
+	bool Emplace(U&& value)
+	{
+		const auto head = this->head.load(std::memory_order_relaxed);
+		if (head - tail.load(std::memory_order_acquire) == N)
+			return false;
+
+		items[head & (N - 1)] = std::forward<U>(value);
+		this->head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::array<T, N> items{};
+	alignas(64) std::atomic<size_t> head = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+};
@@ -0,0 +1,24 @@
+#include "StaleSamplers.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+StaleSamplers::StaleSamplers(uint64_t version, std::vector<Sampler> samplers) :
+	version(version), samplers(std::move(samplers))
+{
+	std::ranges::sort(this->samplers, [](const Sampler& a, const Sampler& b) { return a.device != b.device ? a.device < b.device : a.handle < b.handle; });
+}
+
+uint64_t StaleSamplers::Find(uint64_t device, uint64_t handle, bool unbiased) const
+{
+	const auto it = LowerBound(device, handle);
+	if (it == samplers.end() || it->device != device || it->handle != handle)
+		return 0;
+	return unbiased ? it->unbiased : it->biased;
+}
+
+std::vector<StaleSamplers::Sampler>::const_iterator StaleSamplers::LowerBound(uint64_t device, uint64_t handle) const
+{
+	return std::ranges::lower_bound(samplers, std::pair(device, handle), std::less{}, [](const Sampler& sampler) { return std::pair(sampler.device, sampler.handle); });
+}
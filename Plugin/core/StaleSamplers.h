@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Biased samplers whose descriptors carry another bias than the one a copy of them should have, each
+// paired with replacements written with the current bias and with none, for passes that keep samplers
+// unbiased. Built whenever the bias or the set of biased samplers changes and then only read, so the
+// descriptor copy path looks samplers up without locking: a lower bound per copied range and a walk over
+// the entries inside it.
+//
+// Entries are keyed on the descriptors the game created, and only copy sources are looked up. A sampler
+// the game creates straight into a shader-visible heap is never copied from, so it is never rewritten and
+// keeps the bias it was created with.
+class StaleSamplers
+{
+public:
+	struct Sampler
+	{
+		uint64_t device;
+		uint64_t handle;    // descriptor the game created
+		uint64_t biased;    // the same sampler with the current bias, 0 if it already has it
+		uint64_t unbiased;  // the same sampler without bias, 0 if it already has none or none is needed
+	};
+
+	StaleSamplers() = default;
+
+	// version is the SamplerCache version the samplers were read at.
+	StaleSamplers(uint64_t version, std::vector<Sampler> samplers);
+
+	uint64_t GetVersion() const { return version; }
+	size_t Size() const { return samplers.size(); }
+
+	// Returns the replacement a copy of handle needs, 0 if it needs none.
+	uint64_t Find(uint64_t device, uint64_t handle, bool unbiased) const;
+
+	// Calls write(index, replacement) for every sampler that needs a replacement among count descriptors
+	// starting at first, stride apart, in order. Returns how many there were.
+	template <class Write>
+	size_t ForEachStale(uint64_t device, uint64_t first, uint64_t stride, uint32_t count, bool unbiased, Write&& write) const
+	{
+		size_t found = 0;
+		const auto end = first + uint64_t(count) * stride;
+		for (auto it = LowerBound(device, first); it != samplers.end() && it->device == device && it->handle < end; ++it) {
+			const auto replacement = unbiased ? it->unbiased : it->biased;
+			if (!replacement || (it->handle - first) % stride)
+				continue;
+			write(uint32_t((it->handle - first) / stride), replacement);
+			found++;
+		}
+		return found;
+	}
+
+private:
+	std::vector<Sampler>::const_iterator LowerBound(uint64_t device, uint64_t handle) const;
+
+	uint64_t version = 0;
+	std::vector<Sampler> samplers;  // sorted by device, then handle
+};
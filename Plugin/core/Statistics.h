@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Median and standard deviation over the last N samples.
+template <size_t N>
+class RollingWindow
+{
+public:
+	void Add(float sample)
+	{
+		samples[added % N] = sample;
+		count = std::min(count + 1, N);
+		added++;
+	}
+
+	void Clear()
+	{
+		samples = {};
+		count = 0;
+		added = 0;
+	}
+
+	size_t Size() const { return count; }
+	bool Full() const { return count == N; }
+
+	float Median() const
+	{
+		if (!count)
+			return 0.0f;
+
+		std::array<float, N> sorted;
+		std::copy_n(samples.begin(), count, sorted.begin());
+		const auto middle = sorted.begin() + count / 2;
+		std::nth_element(sorted.begin(), middle, sorted.begin() + count);
+		return *middle;
+	}
+
+	float Stddev() const
+	{
+		if (!count)
+			return 0.0f;
+
+		double sum = 0.0, sumSquares = 0.0;
+		for (size_t i = 0; i < count; i++) {
+			sum += samples[i];
+			sumSquares += double(samples[i]) * samples[i];
+		}
+		const double mean = sum / double(count);
+		return float(std::sqrt(std::max(sumSquares / double(count) - mean * mean, 0.0)));
+	}
+
+private:
+	std::array<float, N> samples{};
+	size_t count = 0;
+	uint64_t added = 0;
+};
+
+// Count, mean, extremes and standard deviation of a stream of integer samples, without storing it.
+struct RunningStats
+{
+	uint64_t count = 0;
+	int64_t total = 0;
+	int64_t min = INT64_MAX;
+	int64_t max = INT64_MIN;
+	double sumSquares = 0.0;
+
+	void Add(int64_t sample)
+	{
+		count++;
+		total += sample;
+		min = std::min(min, sample);
+		max = std::max(max, sample);
+		sumSquares += double(sample) * double(sample);
+	}
+
+	double Mean() const { return count ? double(total) / double(count) : 0.0; }
+
+	double Stddev() const
+	{
+		if (!count)
+			return 0.0;
+		const double mean = Mean();
+		return std::sqrt(std::max(sumSquares / double(count) - mean * mean, 0.0));
+	}
+};
@@ -0,0 +1,38 @@
+#include "TimestampRing.h"
+
+int32_t TimestampRing::Begin()
+{
+	auto& slot = slots[next];
+	if (slot.state != State::Free)
+		return -1;
+
+	slot.state = State::Recording;
+	slot.present = presents;
+	return int32_t(next * 2);
+}
+
+void TimestampRing::End(int32_t query)
+{
+	auto& slot = slots[query / 2];
+	if (slot.state != State::Recording)
+		return;
+
+	slot.state = State::Pending;
+	pending++;
+	next = (next + 1) % Slots;
+}
+
+void TimestampRing::Abandon(int32_t query)
+{
+	auto& slot = slots[query / 2];
+	if (slot.state == State::Recording)
+		slot.state = State::Free;
+}
+
+void TimestampRing::Clear()
+{
+	slots = {};
+	next = 0;
+	oldest = 0;
+	pending = 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Bookkeeping for a ring of begin/end timestamp query pairs that are read back a few frames after they
+// were written, so reading them never waits on the GPU. Age is counted in presents, not measurements: a
+// game may dispatch FSR2 more than once per frame, or not at all, and only a present moves the GPU on.
+// Knows nothing about the graphics API: queries are identified by their index in a pool of QueryCount
+// timestamps, and results are fetched through a callback, which keeps it usable against any device
+// implementation.
+class TimestampRing
+{
+public:
+	static constexpr uint32_t Slots = 4;
+	static constexpr uint32_t QueryCount = Slots * 2;
+
+	// Results are not read back until this many presents happened after the measurement started.
+	static constexpr uint64_t Latency = 2;
+
+	static_assert(Latency < Slots, "the ring needs a free slot while older ones are still in flight");
+
+	// Starts a measurement. Returns the query index to write the begin timestamp to, or -1 if the slot is
+	// still waiting for its results, in which case this dispatch is not measured.
+	int32_t Begin();
+
+	// Finishes the measurement started by Begin, after the end timestamp was written to index + 1.
+	void End(int32_t query);
+
+	// Drops a measurement started by Begin whose end timestamp was never written.
+	void Abandon(int32_t query);
+
+	// Counts a present, before Resolve is called for it.
+	void Present() { presents++; }
+
+	// Reads back every pending measurement that is old enough, oldest first, stopping at the first one
+	// whose results are not available yet. Calls read(first, count, ticks) to fetch query results and
+	// done(milliseconds) for every completed measurement.
+	template <class Read, class Done>
+	void Resolve(uint64_t frequency, Read&& read, Done&& done)
+	{
+		while (pending) {
+			auto& slot = slots[oldest];
+			if (slot.state != State::Pending || presents - slot.present < Latency)
+				return;
+
+			uint64_t ticks[2];
+			if (!read(oldest * 2, 2u, ticks))
+				return;
+
+			if (frequency && ticks[1] >= ticks[0])
+				done(double(ticks[1] - ticks[0]) * 1000.0 / double(frequency));
+
+			slot.state = State::Free;
+			oldest = (oldest + 1) % Slots;
+			pending--;
+		}
+	}
+
+	// Forgets every measurement, for when the query pool is recreated.
+	void Clear();
+
+private:
+	enum class State : uint8_t
+	{
+		Free,
+		Recording,
+		Pending
+	};
+
+	struct Slot
+	{
+		State state = State::Free;
+		uint64_t present = 0;  // presents counted when the measurement started
+	};
+
+	std::array<Slot, Slots> slots{};
+	uint32_t next = 0;
+	uint32_t oldest = 0;
+	uint32_t pending = 0;
+	uint64_t presents = 0;
+};
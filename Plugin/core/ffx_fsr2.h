@@ -0,0 +1,116 @@
+#pragma once
+
+// Subset of ffx_fsr2.h / ffx_fsr2_interface.h from the FidelityFX FSR2 2.2 SDK, matching the version linked into the game.
+
+#include <stddef.h>
+
+#include "ffx_types.h"
+
+typedef int32_t FfxErrorCode;
+
+#define FFX_OK 0
+#define FFX_ERROR_INVALID_POINTER 0x80000000
+#define FFX_ERROR_OUT_OF_MEMORY 0x8000000d
+#define FFX_ERROR_BACKEND_API_ERROR 0x80000011
+
+/// The size of the context specified in 32bit values.
+#define FFX_FSR2_CONTEXT_SIZE (16536)
+
+typedef enum FfxFsr2Pass
+{
+	FFX_FSR2_PASS_DEPTH_CLIP = 0,                  ///< A pass which performs depth clipping.
+	FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH = 1,  ///< A pass which performs reconstruction of previous frame's depth.
+	FFX_FSR2_PASS_LOCK = 2,                        ///< A pass which calculates pixel locks.
+	FFX_FSR2_PASS_ACCUMULATE = 3,                  ///< A pass which performs upscaling.
+	FFX_FSR2_PASS_ACCUMULATE_SHARPEN = 4,          ///< A pass which performs upscaling when sharpening is used.
+	FFX_FSR2_PASS_RCAS = 5,                        ///< A pass which performs sharpening.
+	FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID = 6,   ///< A pass which generates the luminance mipmap chain for the current frame.
+	FFX_FSR2_PASS_GENERATE_REACTIVE = 7,           ///< An optional pass to generate a reactive mask.
+	FFX_FSR2_PASS_TCR_AUTOGENERATE = 8,            ///< An optional pass to generate a texture-and-composition and reactive masks.
+
+	FFX_FSR2_PASS_COUNT  ///< The number of passes performed by FSR2.
+} FfxFsr2Pass;
+
+typedef struct FfxFsr2Interface FfxFsr2Interface;
+
+typedef FfxErrorCode (*FfxFsr2CreateBackendContextFunc)(FfxFsr2Interface* backendInterface, FfxDevice device);
+typedef FfxErrorCode (*FfxFsr2GetDeviceCapabilitiesFunc)(FfxFsr2Interface* backendInterface, FfxDeviceCapabilities* outDeviceCapabilities, FfxDevice device);
+typedef FfxErrorCode (*FfxFsr2DestroyBackendContextFunc)(FfxFsr2Interface* backendInterface);
+typedef FfxErrorCode (*FfxFsr2CreateResourceFunc)(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outResource);
+typedef FfxErrorCode (*FfxFsr2RegisterResourceFunc)(FfxFsr2Interface* backendInterface, const FfxResource* inResource, FfxResourceInternal* outResource);
+typedef FfxErrorCode (*FfxFsr2UnregisterResourcesFunc)(FfxFsr2Interface* backendInterface);
+typedef FfxResourceDescription (*FfxFsr2GetResourceDescriptionFunc)(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+typedef FfxErrorCode (*FfxFsr2DestroyResourceFunc)(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+typedef FfxErrorCode (*FfxFsr2CreatePipelineFunc)(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline);
+typedef FfxErrorCode (*FfxFsr2DestroyPipelineFunc)(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
+typedef FfxErrorCode (*FfxFsr2ScheduleGpuJobFunc)(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job);
+typedef FfxErrorCode (*FfxFsr2ExecuteGpuJobsFunc)(FfxFsr2Interface* backendInterface, FfxCommandList commandList);
+
+typedef struct FfxFsr2Interface
+{
+	FfxFsr2CreateBackendContextFunc fpCreateBackendContext;    ///< A callback function to create and initialize the backend context.
+	FfxFsr2GetDeviceCapabilitiesFunc fpGetDeviceCapabilities;  ///< A callback function to query device capabilites.
+	FfxFsr2DestroyBackendContextFunc fpDestroyBackendContext;  ///< A callback function to destroy the backendcontext. This also dereferences the device.
+	FfxFsr2CreateResourceFunc fpCreateResource;                ///< A callback function to create a resource.
+	FfxFsr2RegisterResourceFunc fpRegisterResource;            ///< A callback function to register an external resource.
+	FfxFsr2UnregisterResourcesFunc fpUnregisterResources;      ///< A callback function to unregister external resource.
+	FfxFsr2GetResourceDescriptionFunc fpGetResourceDescription;  ///< A callback function to retrieve a resource description.
+	FfxFsr2DestroyResourceFunc fpDestroyResource;              ///< A callback function to destroy a resource.
+	FfxFsr2CreatePipelineFunc fpCreatePipeline;                ///< A callback function to create a render or compute pipeline.
+	FfxFsr2DestroyPipelineFunc fpDestroyPipeline;              ///< A callback function to destroy a render or compute pipeline.
+	FfxFsr2ScheduleGpuJobFunc fpScheduleGpuJob;                ///< A callback function to schedule a render job.
+	FfxFsr2ExecuteGpuJobsFunc fpExecuteGpuJobs;                ///< A callback function to execute all queued render jobs.
+
+	void* scratchBuffer;       ///< A preallocated buffer for memory utilized internally by the backend.
+	size_t scratchBufferSize;  ///< Size of the buffer pointed to by <c><i>scratchBuffer</i></c>.
+} FfxFsr2Interface;
+
+typedef struct FfxFsr2ContextDescription
+{
+	uint32_t flags;                 ///< A collection of <c><i>FfxFsr2InitializationFlagBits</i></c>.
+	FfxDimensions2D maxRenderSize;  ///< The maximum size that rendering will be performed at.
+	FfxDimensions2D displaySize;    ///< The size of the presentation resolution targeted by the upscaling process.
+	FfxFsr2Interface callbacks;     ///< A set of pointers to the backend implementation for FSR 2.0.
+	FfxDevice device;               ///< The abstracted device which is passed to some callback functions.
+
+	void* fpMessage;  ///< A pointer to a function that can recieve messages from the runtime.
+} FfxFsr2ContextDescription;
+
+/// The caller-allocated context. Internally the SDK places its private state here, starting with a copy of the
+/// <c><i>FfxFsr2ContextDescription</i></c>, so the callbacks it invokes always receive a pointer into this block.
+typedef struct FfxFsr2Context
+{
+	uint32_t data[FFX_FSR2_CONTEXT_SIZE];  ///< An opaque set of <c>uint32_t</c> which contain the data for the context.
+} FfxFsr2Context;
+
+typedef struct FfxFsr2DispatchDescription
+{
+	FfxCommandList commandList;              ///< The <c><i>FfxCommandList</i></c> to record FSR2 rendering commands into.
+	FfxResource color;                       ///< A <c><i>FfxResource</i></c> containing the color buffer for the current frame (at render resolution).
+	FfxResource depth;                       ///< A <c><i>FfxResource</i></c> containing 32bit depth values for the current frame (at render resolution).
+	FfxResource motionVectors;               ///< A <c><i>FfxResource</i></c> containing 2-dimensional motion vectors (at render resolution if <c><i>FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS</i></c> is not set).
+	FfxResource exposure;                    ///< A optional <c><i>FfxResource</i></c> containing a 1x1 exposure value.
+	FfxResource reactive;                    ///< A optional <c><i>FfxResource</i></c> containing alpha value of reactive objects in the scene.
+	FfxResource transparencyAndComposition;  ///< A optional <c><i>FfxResource</i></c> containing alpha value of special objects in the scene.
+	FfxResource output;                      ///< A <c><i>FfxResource</i></c> containing the output color buffer for the current frame (at presentation resolution).
+	FfxFloatCoords2D jitterOffset;           ///< The subpixel jitter offset applied to the camera.
+	FfxFloatCoords2D motionVectorScale;      ///< The scale factor to apply to motion vectors.
+	FfxDimensions2D renderSize;              ///< The resolution that was used for rendering the input resources.
+	bool enableSharpening;                   ///< Enable an additional sharpening pass.
+	float sharpness;                         ///< The sharpness value between 0 and 1, where 0 is no additional sharpness and 1 is maximum additional sharpness.
+	float frameTimeDelta;                    ///< The time elapsed since the last frame (expressed in milliseconds).
+	float preExposure;                       ///< The pre exposure value (must be > 0.0f)
+	bool reset;                              ///< A boolean value which when set to true, indicates the camera has moved discontinuously.
+	float cameraNear;                        ///< The distance to the near plane of the camera.
+	float cameraFar;                         ///< The distance to the far plane of the camera.
+	float cameraFovAngleVertical;            ///< The camera angle field of view in the vertical direction (expressed in radians).
+	float viewSpaceToMetersFactor;           ///< The scale factor to convert view space units to meters
+
+	// EXPERIMENTAL reactive mask generation parameters
+	bool enableAutoReactive;      ///< A boolean value to indicate internal reactive autogeneration should be used
+	FfxResource colorOpaqueOnly;  ///< A <c><i>FfxResource</i></c> containing the opaque only color buffer for the current frame (at render resolution).
+	float autoTcThreshold;        ///< Cutoff value for TC
+	float autoTcScale;            ///< A value to scale the transparency and composition mask
+	float autoReactiveScale;      ///< A value to scale the reactive mask
+	float autoReactiveMax;        ///< A value to clamp the reactive mask
+} FfxFsr2DispatchDescription;
@@ -0,0 +1,112 @@
+#include "ContextPool.h"
+#include "FfxUtil.h"
+#include "Fsr2Hooks.h"
+#include "FuzzInput.h"
+#include "ffx_fsr2_mock.h"
+
+// Feeds arbitrary context descriptions through the context create hook, validation and the ContextPool
+// in front of the FSR2 mock. Each input is a sequence of creates, dispatches and destroys on up to four
+// live contexts spread over three devices, and of device removals, so pooled contexts are reused, evicted
+// and released in every order. Whatever is left is torn down at the end of the input.
+//
+// The mock allocates every internal resource in host memory. Contexts larger than MaxPixels fail to
+// create the way they would on a device out of memory, which the pool has to handle as well.
+
+namespace
+{
+	constexpr uint64_t MaxPixels = 128 * 128;
+	constexpr size_t MaxLive = 4;
+	constexpr uintptr_t Devices = 3;
+	constexpr size_t MaxOperations = 32;
+
+	FfxDevice MakeDevice(uintptr_t id)
+	{
+		return reinterpret_cast<FfxDevice>((0x100 + id) << 4);
+	}
+
+	FfxErrorCode CreateWithinBudget(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription)
+	{
+		// The mock rounds zero sizes up to one
+		const auto pixels = [](FfxDimensions2D size) { return uint64_t(std::max(size.width, 1u)) * std::max(size.height, 1u); };
+		if (pixels(contextDescription->maxRenderSize) > MaxPixels || pixels(contextDescription->displaySize) > MaxPixels)
+			return FFX_ERROR_OUT_OF_MEMORY;
+		return ffxFsr2ContextCreateMock(context, contextDescription);
+	}
+
+	struct Live
+	{
+		std::unique_ptr<Mock::Harness> harness;
+		FfxDimensions2D maxRenderSize;
+	};
+
+	void Destroy(Live& live)
+	{
+		if (ffxFsr2ContextDestroyMock(live.harness->context.get()) != FFX_OK)
+			std::abort();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	static const bool initialized = [] {
+		HostLog::threshold = HostLog::Level::None;
+		auto hooks = Fsr2Hooks::GetSingleton();
+		hooks->SetCreateOriginal(&CreateWithinBudget);
+		hooks->SetDispatchOriginal(&ffxFsr2ContextDispatchMock);
+		hooks->SetDispatchLayout(FfxLayout::Version::Fsr22);
+		return true;
+	}();
+	(void)initialized;
+
+	auto pool = ContextPool::GetSingleton();
+	std::vector<Live> live;
+	FuzzInput input(data, size);
+
+	for (size_t i = 0; i < MaxOperations && !input.Empty(); i++) {
+		const auto operation = input.Take<uint8_t>();
+		const auto index = live.empty() ? 0 : size_t(input.Take<uint8_t>()) % live.size();
+		switch (operation % 4) {
+		case 0:
+			{
+				if (live.size() == MaxLive)
+					break;
+
+				auto harness = std::make_unique<Mock::Harness>();
+				const FfxDimensions2D maxRenderSize{ input.Take<uint32_t>(), input.Take<uint32_t>() };
+				const FfxDimensions2D displaySize{ input.Take<uint32_t>(), input.Take<uint32_t>() };
+				const auto flags = input.Take<uint32_t>();
+				auto description = harness->MakeContextDescription(maxRenderSize, displaySize, MakeDevice(input.Take<uint8_t>() % Devices), flags);
+				if (Fsr2Hooks::ContextCreate_hook(harness->context.get(), &description) == FFX_OK)
+					live.push_back({ std::move(harness), maxRenderSize });
+			}
+			break;
+		case 1:
+			if (!live.empty()) {
+				auto dispatch = Mock::MakeDispatchDescription(live[index].maxRenderSize);
+				dispatch.reset = input.TakeBool();
+				Fsr2Hooks::ContextDispatch_hook(live[index].harness->context.get(), &dispatch);
+				Mock::GetBackendContext(FfxUtil::GetInterface(live[index].harness->context.get()))->executed.clear();
+			}
+			break;
+		case 2:
+			if (!live.empty()) {
+				Destroy(live[index]);
+				live.erase(live.begin() + std::ptrdiff_t(index));
+			}
+			break;
+		default:
+			// The game destroys its contexts before the device goes away
+			for (auto& context : live)
+				Destroy(context);
+			live.clear();
+			pool->ReleaseDevice(MakeDevice(input.Take<uint8_t>() % Devices));
+			break;
+		}
+	}
+
+	for (auto& context : live)
+		Destroy(context);
+	for (uintptr_t device = 0; device < Devices; device++)
+		pool->ReleaseDevice(MakeDevice(device));
+	return 0;
+}
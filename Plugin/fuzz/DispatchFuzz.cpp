@@ -0,0 +1,173 @@
+#include "Config.h"
+#include "ContextPool.h"
+#include "FfxUtil.h"
+#include "Fsr2Hooks.h"
+#include "FuzzInput.h"
+#include "HookProfiler.h"
+#include "ffx_fsr2_mock.h"
+
+// Feeds arbitrary dispatch descriptions through the dispatch hook in front of the FSR2 mock, in both SDK
+// layouts, mixed with what the present thread does between dispatches: resolution detection adjusting the
+// bias with sizes of its own, present counting, hot keys and telemetry switching. Each input is a sequence
+// of those operations. The resources are the mock's own, every field the plugin reads comes from the input.
+// Bools are taken as 0 or 1, the game's compiler never stores anything else in them.
+//
+// Besides the sanitizers, the listeners check what reaches the rest of the plugin: only dispatches that
+// pass validation, and only finite biases inside the configured clamp.
+
+namespace
+{
+	// Small, the mock clears its history in host memory on every reset
+	constexpr FfxDimensions2D MaxRenderSize{ 256, 144 };
+	constexpr FfxDimensions2D DisplaySize{ 512, 288 };
+	constexpr size_t MaxOperations = 64;
+
+	FfxLayout::Version _layout = FfxLayout::Version::Fsr22;
+	bool _forceDisable = false;
+
+	void Check(bool condition, const char* what)
+	{
+		if (!condition) {
+			std::fprintf(stderr, "%s\n", what);
+			std::abort();
+		}
+	}
+
+	float OnBiasApplied(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias, bool)
+	{
+		const auto settings = Config::GetSingleton()->Get();
+		Check(renderSize.width && displaySize.width, "bias applied for a zero width");
+		Check(std::isfinite(bias), "non-finite bias applied");
+		Check(_forceDisable ? bias == 0.0f : bias >= settings->bias.minBias && bias <= settings->bias.maxBias, "bias outside the configured clamp");
+		return bias;
+	}
+
+	void OnDispatched(const FfxLayout::DispatchFields& fields)
+	{
+		Check(FfxUtil::ValidateDispatch(fields, Fsr2Hooks::GetSingleton()->GetDisplaySize()) == FfxUtil::DispatchError::None, "invalid dispatch passed on");
+	}
+
+	// The mock runtime reads the 2.2 layout, a 2.0 description is translated the way the real 2.0 SDK would read it
+	FfxErrorCode DispatchOriginal(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams)
+	{
+		if (_layout == FfxLayout::Version::Fsr22)
+			return ffxFsr2ContextDispatchMock(context, dispatchParams);
+
+		const auto& old = *reinterpret_cast<const FfxLayout::DispatchDescription20*>(dispatchParams);
+		auto description = Mock::MakeDispatchDescription(old.renderSize);
+		description.jitterOffset = old.jitterOffset;
+		description.motionVectorScale = old.motionVectorScale;
+		description.enableSharpening = old.enableSharpening;
+		description.sharpness = old.sharpness;
+		description.frameTimeDelta = old.frameTimeDelta;
+		description.reset = old.reset;
+		description.cameraNear = old.cameraNear;
+		description.cameraFar = old.cameraFar;
+		description.cameraFovAngleVertical = old.cameraFovAngleVertical;
+		return ffxFsr2ContextDispatchMock(context, &description);
+	}
+
+	template <class Description>
+	void TakeFields(FuzzInput& input, Description& description)
+	{
+		description.jitterOffset = { input.Take<float>(), input.Take<float>() };
+		description.motionVectorScale = { input.Take<float>(), input.Take<float>() };
+		description.renderSize = { input.Take<uint32_t>(), input.Take<uint32_t>() };
+		description.enableSharpening = input.TakeBool();
+		description.sharpness = input.Take<float>();
+		description.frameTimeDelta = input.Take<float>();
+		description.reset = input.TakeBool();
+		description.cameraNear = input.Take<float>();
+		description.cameraFar = input.Take<float>();
+		description.cameraFovAngleVertical = input.Take<float>();
+	}
+
+	FfxErrorCode Dispatch(FuzzInput& input, Mock::Harness& harness)
+	{
+		const auto valid = Mock::MakeDispatchDescription(MaxRenderSize);
+		if (_layout == FfxLayout::Version::Fsr22) {
+			auto description = valid;
+			TakeFields(input, description);
+			description.preExposure = input.Take<float>();
+			return Fsr2Hooks::ContextDispatch_hook(harness.context.get(), &description);
+		}
+
+		FfxLayout::DispatchDescription20 description{};
+		description.commandList = valid.commandList;
+		description.color = valid.color;
+		description.depth = valid.depth;
+		description.motionVectors = valid.motionVectors;
+		description.exposure = valid.exposure;
+		description.reactive = valid.reactive;
+		description.transparencyAndComposition = valid.transparencyAndComposition;
+		description.output = valid.output;
+		TakeFields(input, description);
+		return Fsr2Hooks::ContextDispatch_hook(harness.context.get(), reinterpret_cast<FfxFsr2DispatchDescription*>(&description));
+	}
+
+	// Created on the first input and torn down at exit, so LeakSanitizer only reports what inputs leak
+	struct Session
+	{
+		inline static const auto Device = reinterpret_cast<FfxDevice>(0x1000);
+
+		Mock::Harness harness;
+
+		Session()
+		{
+			HostLog::threshold = HostLog::Level::None;
+
+			Fsr2Hooks::Listeners listeners;
+			listeners.biasApplied = &OnBiasApplied;
+			listeners.dispatched = &OnDispatched;
+			auto hooks = Fsr2Hooks::GetSingleton();
+			hooks->SetListeners(listeners);
+			hooks->SetCreateOriginal(&ffxFsr2ContextCreateMock);
+			hooks->SetDispatchOriginal(&DispatchOriginal);
+
+			auto description = harness.MakeContextDescription(MaxRenderSize, DisplaySize, Device);
+			Check(Fsr2Hooks::ContextCreate_hook(harness.context.get(), &description) == FFX_OK, "failed to create the context");
+		}
+
+		~Session()
+		{
+			ffxFsr2ContextDestroyMock(harness.context.get());
+			ContextPool::GetSingleton()->ReleaseDevice(Device);
+		}
+	};
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	static Session session;
+	auto& harness = session.harness;
+	auto hooks = Fsr2Hooks::GetSingleton();
+	FuzzInput input(data, size);
+
+	_layout = input.TakeBool() ? FfxLayout::Version::Fsr20 : FfxLayout::Version::Fsr22;
+	hooks->SetDispatchLayout(_layout);
+
+	for (size_t i = 0; i < MaxOperations && !input.Empty(); i++) {
+		switch (input.Take<uint8_t>() % 4) {
+		case 0:
+			Check(Dispatch(input, harness) == FFX_OK, "dispatch failed");
+			break;
+		case 1:
+			hooks->AdjustBias({ input.Take<uint32_t>(), input.Take<uint32_t>() }, { input.Take<uint32_t>(), input.Take<uint32_t>() }, false);
+			break;
+		case 2:
+			hooks->CountPresent();
+			break;
+		default:
+			_forceDisable = input.TakeBool();
+			hooks->forceDisable.store(_forceDisable, std::memory_order_relaxed);
+			hooks->biasOffsetIndex.store(input.Take<uint8_t>() % std::size(Fsr2Hooks::BiasOffsets), std::memory_order_relaxed);
+			HookProfiler::GetSingleton()->enabled = input.TakeBool();
+			break;
+		}
+	}
+
+	// The worker that drains telemetry in the game is not running here
+	Mock::GetBackendContext(FfxUtil::GetInterface(harness.context.get()))->executed.clear();
+	HookProfiler::GetSingleton()->Drain();
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include "EventDecoder.h"
+
+#include <sstream>
+
+// Feeds arbitrary files through the event log decoder and formats every record it returns, the way
+// tools/event_decode does. Header, formats and records all come from the input.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	std::istringstream stream(std::string(reinterpret_cast<const char*>(data), size));
+	EventDecoder decoder(stream);
+	if (decoder.ReadHeader() != EventDecoder::Status::Ok)
+		return 0;
+
+	const auto& definitions = decoder.GetDefinitions();
+	EventDecoder::Record record;
+	while (decoder.Next(record) == EventDecoder::Status::Ok) {
+		const auto& definition = definitions[record.event];
+		const auto message = EventFormat::Format(definition.format, definition.types, record.args.data());
+		if (message.size() > definition.format.size() + record.args.size() * 64)
+			std::abort();
+	}
+	return 0;
+}
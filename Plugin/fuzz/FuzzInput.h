@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Splits a fuzz input into values, a minimal FuzzedDataProvider that builds with any compiler. Reads past
+// the end give zeros, so every input is a valid one, however short. Floats are taken bit for bit and cover
+// NaN, infinities and denormals.
+class FuzzInput
+{
+public:
+	FuzzInput(const uint8_t* data, size_t size) :
+		data(data), size(size) {}
+
+	template <class T>
+	T Take()
+	{
+		T value{};
+		const auto count = std::min(sizeof(T), size - offset);
+		if (count)
+			std::memcpy(&value, data + offset, count);
+		offset += count;
+		return value;
+	}
+
+	bool TakeBool() { return Take<uint8_t>() & 1; }
+
+	bool Empty() const { return offset == size; }
+
+private:
+	const uint8_t* data;
+	size_t size;
+	size_t offset = 0;
+};
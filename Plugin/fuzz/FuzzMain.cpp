@@ -0,0 +1,208 @@
+// Stand-in for libFuzzer's main where it is not available, e.g. with GCC or MSVC. Takes the same command
+// line: files and directories of inputs, -runs=N further inputs mutated from them, -seed=, -max_len=,
+// -timeout= in seconds and -dict= with tokens in the libFuzzer and AFL dictionary format. Every run is reproducible from its seed. A crash is reported by the sanitizers,
+// which under ASan write the input that caused it to crash-input first; an input that takes longer than
+// the timeout is written to slow-input and fails the run. AFL++ can drive the same binary with @@.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SANITIZE_ADDRESS__)
+#	define FUZZ_ASAN
+#elif defined(__has_feature)
+#	if __has_feature(address_sanitizer)
+#		define FUZZ_ASAN
+#	endif
+#endif
+
+#ifdef FUZZ_ASAN
+#	include <sanitizer/common_interface_defs.h>
+#endif
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace
+{
+	using Input = std::vector<uint8_t>;
+
+	const Input* _current = nullptr;
+
+	void WriteInput(const char* path, const Input& input)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(input.data()), std::streamsize(input.size()));
+	}
+
+	void LoadInputs(const std::filesystem::path& path, std::vector<Input>& inputs)
+	{
+		std::error_code error;
+		if (std::filesystem::is_directory(path, error)) {
+			for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+				if (entry.is_regular_file())
+					LoadInputs(entry.path(), inputs);
+			}
+			return;
+		}
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			std::fprintf(stderr, "failed to open %s\n", path.string().c_str());
+			return;
+		}
+		inputs.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// One "token" per line, optionally named as name="token", with \\, \" and \xNN escapes
+	void LoadDictionary(const char* path, std::vector<Input>& tokens)
+	{
+		std::ifstream file(path);
+		if (!file) {
+			std::fprintf(stderr, "failed to open %s\n", path);
+			return;
+		}
+
+		std::string line;
+		while (std::getline(file, line)) {
+			const auto start = line.find('"');
+			const auto end = line.rfind('"');
+			if (line.starts_with('#') || start == std::string::npos || end <= start)
+				continue;
+
+			Input token;
+			for (size_t i = start + 1; i < end; i++) {
+				if (line[i] == '\\' && i + 1 < end && line[i + 1] == 'x' && i + 3 < end) {
+					token.push_back(uint8_t(std::stoul(line.substr(i + 2, 2), nullptr, 16)));
+					i += 3;
+				} else if (line[i] == '\\' && i + 1 < end) {
+					token.push_back(uint8_t(line[++i]));
+				} else {
+					token.push_back(uint8_t(line[i]));
+				}
+			}
+			tokens.push_back(std::move(token));
+		}
+	}
+
+	// Values that sit on the edges of what the plugin checks: zero, one, the largest accepted dimension and
+	// one past it, all bits set, and the float NaN, infinity, denormal and negative zero patterns
+	constexpr uint32_t Interesting[] = { 0, 1, 16384, 16385, 0xFFFFFFFF, 0x7FC00000, 0x7F800000, 0xFF800000, 0x00000001, 0x80000000, 0x3F800000 };
+
+	Input Mutate(const std::vector<Input>& inputs, const std::vector<Input>& tokens, size_t maxLength, std::mt19937_64& random)
+	{
+		Input input = inputs.empty() ? Input{} : inputs[random() % inputs.size()];
+		const auto mutations = 1 + random() % 8;
+		for (size_t i = 0; i < mutations; i++) {
+			const auto position = input.empty() ? 0 : size_t(random() % input.size());
+			switch (random() % (tokens.empty() ? 5 : 7)) {
+			case 0:
+				if (!input.empty())
+					input[position] ^= uint8_t(1u << (random() % 8));
+				break;
+			case 1:
+				if (!input.empty())
+					input[position] = uint8_t(random());
+				break;
+			case 2:
+				for (auto count = 1 + random() % 16; count; count--)
+					input.insert(input.begin() + std::ptrdiff_t(position), uint8_t(random()));
+				break;
+			case 3:
+				if (!input.empty())
+					input.erase(input.begin() + std::ptrdiff_t(position));
+				break;
+			case 4:
+				{
+					const auto value = Interesting[random() % std::size(Interesting)];
+					for (size_t byte = 0; byte < 4 && position + byte < input.size(); byte++)
+						input[position + byte] = uint8_t(value >> (8 * byte));
+				}
+				break;
+			case 5:
+				{
+					const auto& token = tokens[random() % tokens.size()];
+					input.insert(input.begin() + std::ptrdiff_t(position), token.begin(), token.end());
+				}
+				break;
+			default:
+				{
+					// Overwriting keeps the length fields in front of the bytes right
+					const auto& token = tokens[random() % tokens.size()];
+					for (size_t byte = 0; byte < token.size() && position + byte < input.size(); byte++)
+						input[position + byte] = token[byte];
+				}
+				break;
+			}
+		}
+		if (input.size() > maxLength)
+			input.resize(maxLength);
+		return input;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t runs = 0, maxLength = 4096;
+	uint64_t seed = 1;
+	double timeout = 1.0;
+	std::vector<Input> inputs, tokens;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg = argv[i];
+		if (arg.starts_with("-runs="))
+			runs = std::strtoull(argv[i] + 6, nullptr, 10);
+		else if (arg.starts_with("-seed="))
+			seed = std::strtoull(argv[i] + 6, nullptr, 10);
+		else if (arg.starts_with("-max_len="))
+			maxLength = std::strtoull(argv[i] + 9, nullptr, 10);
+		else if (arg.starts_with("-timeout="))
+			timeout = std::strtod(argv[i] + 9, nullptr);
+		else if (arg.starts_with("-dict="))
+			LoadDictionary(argv[i] + 6, tokens);
+		else if (arg.starts_with("-"))
+			std::fprintf(stderr, "ignoring %s\n", argv[i]);
+		else
+			LoadInputs(argv[i], inputs);
+	}
+
+#ifdef FUZZ_ASAN
+	__sanitizer_set_death_callback([] {
+		if (_current)
+			WriteInput("crash-input", *_current);
+	});
+#endif
+
+	std::mt19937_64 random(seed);
+	const auto corpusSize = inputs.size();
+	double slowest = 0.0;
+	bool slow = false;
+
+	// The corpus first, then the mutations, each one timed on its own
+	for (size_t i = 0; i < corpusSize + runs; i++) {
+		const auto input = i < corpusSize ? inputs[i] : Mutate(inputs, tokens, maxLength, random);
+		_current = &input;
+
+		const auto start = std::chrono::steady_clock::now();
+		LLVMFuzzerTestOneInput(input.data(), input.size());
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		_current = nullptr;
+		slowest = std::max(slowest, seconds);
+		if (seconds > timeout && !slow) {
+			std::fprintf(stderr, "input %zu took %.3f s, written to slow-input\n", i, seconds);
+			WriteInput("slow-input", input);
+			slow = true;
+		}
+	}
+
+	std::printf("ran %zu inputs (%zu from the corpus), slowest %.3f ms\n", corpusSize + runs, corpusSize, slowest * 1000.0);
+	return slow ? 1 : 0;
+}
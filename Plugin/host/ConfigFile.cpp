@@ -0,0 +1,9 @@
+#include "Config.h"
+
+// Stands in for src/ConfigFile.cpp on hosts without toml++. Tests and benchmarks run on the default
+// settings and never call Config::Start, so the file is only reported, never read.
+bool Config::Parse(Settings&) const
+{
+	ERROR("Built without toml++, ignoring {}", path.string());
+	return false;
+}
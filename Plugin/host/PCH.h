@@ -0,0 +1,80 @@
+#pragma once
+
+// Stands in for src/PCH.h when the portable plugin modules are built on the host for tests and
+// benchmarks: the same standard headers and logging macros, without Windows or DKUtil. Log lines go to
+// stderr through fmt, which takes the same format strings.
+
+// c
+#include <cassert>
+#include <cfloat>
+#include <cinttypes>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// cxx
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+using namespace std::literals;
+
+// Plugin
+#include "Plugin.h"
+
+namespace HostLog
+{
+	enum class Level
+	{
+		Debug,
+		Info,
+		Error,
+		None
+	};
+
+	// Benchmarks raise this to keep the output readable
+	inline std::atomic<Level> threshold = Level::Info;
+
+	template <class... Args>
+	void Write(Level level, const char* name, fmt::format_string<Args...> format, Args&&... args)
+	{
+		if (level < threshold.load(std::memory_order_relaxed))
+			return;
+		fmt::print(stderr, "[{}] {}\n", name, fmt::format(format, std::forward<Args>(args)...));
+	}
+}
+
+#define DEBUG(...) HostLog::Write(HostLog::Level::Debug, "debug", __VA_ARGS__)
+#define INFO(...) HostLog::Write(HostLog::Level::Info, "info", __VA_ARGS__)
+#define ERROR(...) HostLog::Write(HostLog::Level::Error, "error", __VA_ARGS__)
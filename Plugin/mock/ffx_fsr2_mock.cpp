@@ -0,0 +1,349 @@
+#include "ffx_fsr2_mock.h"
+
+#include "FfxUtil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <new>
+
+namespace
+{
+	constexpr uint32_t ScratchMagic = 0x4B434F4D;  // "MOCK"
+
+	struct Scratch
+	{
+		uint32_t magic;
+		Mock::BackendContext context;
+	};
+
+	Mock::BackendContext* GetContext(FfxFsr2Interface* backendInterface)
+	{
+		return Mock::GetBackendContext(backendInterface);
+	}
+
+	std::map<FfxDevice, size_t>& DeviceReferences()
+	{
+		static std::map<FfxDevice, size_t> references;
+		return references;
+	}
+
+	size_t GetFloatChannels(FfxSurfaceFormat format)
+	{
+		switch (format) {
+		case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+			return 4;
+		case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+			return 2;
+		case FFX_SURFACE_FORMAT_R32_FLOAT:
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+	Mock::Resource* GetResource(Mock::BackendContext& backend, FfxResourceInternal resource)
+	{
+		if (resource.internalIndex < 0 || static_cast<size_t>(resource.internalIndex) >= backend.resources.size())
+			return nullptr;
+		auto& found = backend.resources[resource.internalIndex];
+		return found.alive ? &found : nullptr;
+	}
+
+	void Clear(Mock::BackendContext& backend, const FfxClearFloatJobDescription& job)
+	{
+		auto resource = GetResource(backend, job.target);
+		if (!resource || resource->memory.empty())
+			return;
+
+		const auto texelSize = FfxUtil::GetFormatSize(resource->description.format);
+		const auto channels = GetFloatChannels(resource->description.format);
+		if (channels) {
+			for (size_t offset = 0; offset + texelSize <= resource->memory.size(); offset += texelSize)
+				std::memcpy(resource->memory.data() + offset, job.color, channels * sizeof(float));
+		} else {
+			const auto value = static_cast<uint8_t>(std::clamp(job.color[0], 0.0f, 1.0f) * 255.0f);
+			std::memset(resource->memory.data(), value, resource->memory.size());
+		}
+	}
+
+	void Copy(Mock::BackendContext& backend, const FfxCopyJobDescription& job)
+	{
+		auto src = GetResource(backend, job.src);
+		auto dst = GetResource(backend, job.dst);
+		if (!src || !dst || src == dst)
+			return;
+		std::memcpy(dst->memory.data(), src->memory.data(), std::min(src->memory.size(), dst->memory.size()));
+	}
+
+	FfxErrorCode CreateBackendContext(FfxFsr2Interface* backendInterface, FfxDevice device)
+	{
+		if (!backendInterface || !backendInterface->scratchBuffer || backendInterface->scratchBufferSize < sizeof(Scratch))
+			return FFX_ERROR_INVALID_POINTER;
+
+		auto scratch = new (backendInterface->scratchBuffer) Scratch{ ScratchMagic, {} };
+		scratch->context.device = device;
+		DeviceReferences()[device]++;
+		return FFX_OK;
+	}
+
+	FfxErrorCode GetDeviceCapabilities(FfxFsr2Interface*, FfxDeviceCapabilities* outDeviceCapabilities, FfxDevice)
+	{
+		if (!outDeviceCapabilities)
+			return FFX_ERROR_INVALID_POINTER;
+
+		outDeviceCapabilities->minimumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+		outDeviceCapabilities->waveLaneCountMin = 32;
+		outDeviceCapabilities->waveLaneCountMax = 64;
+		outDeviceCapabilities->fp16Supported = true;
+		outDeviceCapabilities->raytracingSupported = false;
+		return FFX_OK;
+	}
+
+	FfxErrorCode DestroyBackendContext(FfxFsr2Interface* backendInterface)
+	{
+		if (!GetContext(backendInterface))
+			return FFX_ERROR_INVALID_POINTER;
+
+		auto scratch = static_cast<Scratch*>(backendInterface->scratchBuffer);
+		if (!--DeviceReferences()[scratch->context.device])
+			DeviceReferences().erase(scratch->context.device);
+		scratch->context.~BackendContext();
+		scratch->magic = 0;
+		return FFX_OK;
+	}
+
+	FfxErrorCode CreateResource(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outResource)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend || !createResourceDescription || !outResource)
+			return FFX_ERROR_INVALID_POINTER;
+
+		const auto& description = createResourceDescription->resourceDescription;
+
+		Mock::Resource resource;
+		resource.description = description;
+		if (createResourceDescription->name)
+			resource.name = createResourceDescription->name;
+
+		size_t bytes = description.width;
+		if (description.type != FFX_RESOURCE_TYPE_BUFFER)
+			bytes = size_t(std::max(description.width, 1u)) * std::max(description.height, 1u) * std::max(description.depth, 1u) * FfxUtil::GetFormatSize(description.format);
+		resource.memory.resize(bytes);
+
+		if (createResourceDescription->initData && createResourceDescription->initDataSize)
+			std::memcpy(resource.memory.data(), createResourceDescription->initData, std::min<size_t>(bytes, createResourceDescription->initDataSize));
+
+		// Static resources are created before any registration, keep their indices stable
+		backend->resources.resize(backend->staticResourceCount);
+		backend->resources.push_back(std::move(resource));
+		backend->staticResourceCount++;
+		backend->hostBytes += bytes;
+
+		outResource->internalIndex = static_cast<int32_t>(backend->staticResourceCount - 1);
+		return FFX_OK;
+	}
+
+	FfxErrorCode RegisterResource(FfxFsr2Interface* backendInterface, const FfxResource* inResource, FfxResourceInternal* outResource)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend || !inResource || !outResource)
+			return FFX_ERROR_INVALID_POINTER;
+
+		if (!inResource->resource) {
+			outResource->internalIndex = -1;
+			return FFX_OK;
+		}
+
+		Mock::Resource resource;
+		resource.description = inResource->description;
+		resource.name = inResource->name;
+		resource.external = true;
+		backend->resources.push_back(std::move(resource));
+
+		outResource->internalIndex = static_cast<int32_t>(backend->resources.size() - 1);
+		return FFX_OK;
+	}
+
+	FfxErrorCode UnregisterResources(FfxFsr2Interface* backendInterface)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend)
+			return FFX_ERROR_INVALID_POINTER;
+
+		backend->resources.resize(backend->staticResourceCount);
+		return FFX_OK;
+	}
+
+	FfxResourceDescription GetResourceDescription(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+	{
+		auto backend = GetContext(backendInterface);
+		auto found = backend ? GetResource(*backend, resource) : nullptr;
+		return found ? found->description : FfxResourceDescription{};
+	}
+
+	FfxErrorCode DestroyResource(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend)
+			return FFX_ERROR_INVALID_POINTER;
+
+		auto found = GetResource(*backend, resource);
+		if (found) {
+			backend->hostBytes -= found->memory.size();
+			found->memory = {};
+			found->alive = false;
+		}
+		return FFX_OK;
+	}
+
+	FfxErrorCode CreatePipeline(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend || !pipelineDescription || !outPipeline)
+			return FFX_ERROR_INVALID_POINTER;
+
+		Mock::Pipeline pipeline;
+		pipeline.passId = passId;
+		pipeline.contextFlags = pipelineDescription->contextFlags;
+		if (pipelineDescription->samplers)
+			pipeline.samplers.assign(pipelineDescription->samplers, pipelineDescription->samplers + pipelineDescription->samplerCount);
+		if (pipelineDescription->rootConstantBufferSizes)
+			pipeline.rootConstantBufferSizes.assign(pipelineDescription->rootConstantBufferSizes, pipelineDescription->rootConstantBufferSizes + pipelineDescription->rootConstantBufferCount);
+		backend->pipelines.push_back(std::move(pipeline));
+
+		const auto handle = reinterpret_cast<void*>(static_cast<uintptr_t>(backend->pipelines.size()));
+		*outPipeline = {};
+		outPipeline->rootSignature = handle;
+		outPipeline->pipeline = handle;
+		outPipeline->constCount = pipelineDescription->rootConstantBufferCount;
+		return FFX_OK;
+	}
+
+	FfxErrorCode DestroyPipeline(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend || !pipeline)
+			return FFX_ERROR_INVALID_POINTER;
+
+		const auto index = reinterpret_cast<uintptr_t>(pipeline->pipeline);
+		if (index > 0 && index <= backend->pipelines.size())
+			backend->pipelines[index - 1].alive = false;
+
+		pipeline->rootSignature = nullptr;
+		pipeline->pipeline = nullptr;
+		return FFX_OK;
+	}
+
+	FfxErrorCode ScheduleGpuJob(FfxFsr2Interface* backendInterface, const FfxGpuJobDescription* job)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend || !job)
+			return FFX_ERROR_INVALID_POINTER;
+
+		backend->queue.push_back(*job);
+		return FFX_OK;
+	}
+
+	FfxErrorCode ExecuteGpuJobs(FfxFsr2Interface* backendInterface, FfxCommandList commandList)
+	{
+		auto backend = GetContext(backendInterface);
+		if (!backend)
+			return FFX_ERROR_INVALID_POINTER;
+
+		for (auto& job : backend->queue) {
+			if (job.jobType == FFX_GPU_JOB_CLEAR_FLOAT)
+				Clear(*backend, job.clearJobDescriptor);
+			else if (job.jobType == FFX_GPU_JOB_COPY)
+				Copy(*backend, job.copyJobDescriptor);
+
+			backend->executed.push_back({ commandList, backend->submissions, job });
+		}
+
+		backend->queue.clear();
+		backend->submissions++;
+		return FFX_OK;
+	}
+}
+
+Mock::BackendContext* Mock::GetBackendContext(const FfxFsr2Interface* backendInterface)
+{
+	if (!backendInterface || !backendInterface->scratchBuffer || backendInterface->scratchBufferSize < sizeof(Scratch))
+		return nullptr;
+
+	auto scratch = static_cast<Scratch*>(backendInterface->scratchBuffer);
+	return scratch->magic == ScratchMagic ? &scratch->context : nullptr;
+}
+
+size_t Mock::GetDeviceReferences(FfxDevice device)
+{
+	const auto found = DeviceReferences().find(device);
+	return found != DeviceReferences().end() ? found->second : 0;
+}
+
+Mock::Harness::Harness() :
+	scratch(ffxFsr2GetScratchMemorySizeMock())
+{
+	std::memset(context.get(), 0, sizeof(FfxFsr2Context));
+}
+
+FfxFsr2ContextDescription Mock::Harness::MakeContextDescription(FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize, FfxDevice device, uint32_t flags)
+{
+	FfxFsr2ContextDescription description{};
+	description.flags = flags;
+	description.maxRenderSize = maxRenderSize;
+	description.displaySize = displaySize;
+	description.device = device;
+	ffxFsr2GetInterfaceMock(&description.callbacks, scratch.data(), scratch.size());
+	return description;
+}
+
+FfxFsr2DispatchDescription Mock::MakeDispatchDescription(FfxDimensions2D renderSize)
+{
+	static int resources[4];
+
+	FfxFsr2DispatchDescription description{};
+	description.color.resource = &resources[0];
+	description.depth.resource = &resources[1];
+	description.motionVectors.resource = &resources[2];
+	description.output.resource = &resources[3];
+	description.renderSize = renderSize;
+	description.jitterOffset = { 0.25f, -0.25f };
+	description.motionVectorScale = { float(renderSize.width), float(renderSize.height) };
+	description.sharpness = 0.5f;
+	description.frameTimeDelta = 16.6f;
+	description.preExposure = 1.0f;
+	description.cameraNear = 0.1f;
+	description.cameraFar = 10000.0f;
+	description.cameraFovAngleVertical = 1.0f;
+	return description;
+}
+
+size_t ffxFsr2GetScratchMemorySizeMock()
+{
+	return sizeof(Scratch);
+}
+
+FfxErrorCode ffxFsr2GetInterfaceMock(FfxFsr2Interface* outInterface, void* scratchBuffer, size_t scratchBufferSize)
+{
+	if (!outInterface || !scratchBuffer || scratchBufferSize < sizeof(Scratch))
+		return FFX_ERROR_INVALID_POINTER;
+
+	std::memset(scratchBuffer, 0, scratchBufferSize);
+
+	outInterface->fpCreateBackendContext = &CreateBackendContext;
+	outInterface->fpGetDeviceCapabilities = &GetDeviceCapabilities;
+	outInterface->fpDestroyBackendContext = &DestroyBackendContext;
+	outInterface->fpCreateResource = &CreateResource;
+	outInterface->fpRegisterResource = &RegisterResource;
+	outInterface->fpUnregisterResources = &UnregisterResources;
+	outInterface->fpGetResourceDescription = &GetResourceDescription;
+	outInterface->fpDestroyResource = &DestroyResource;
+	outInterface->fpCreatePipeline = &CreatePipeline;
+	outInterface->fpDestroyPipeline = &DestroyPipeline;
+	outInterface->fpScheduleGpuJob = &ScheduleGpuJob;
+	outInterface->fpExecuteGpuJobs = &ExecuteGpuJobs;
+	outInterface->scratchBuffer = scratchBuffer;
+	outInterface->scratchBufferSize = scratchBufferSize;
+	return FFX_OK;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+// CPU-only FSR2 backend and a minimal FSR2 runtime that drives it, for exercising the plugin's
+// interposition logic without a GPU. Everything is deterministic: resources are host memory,
+// pipelines are recorded descriptions with sequential handles, and jobs are recorded into a queue
+// that ffxFsr2ExecuteGpuJobs moves into an execution log.
+
+#include "ffx_fsr2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mock
+{
+	struct Resource
+	{
+		FfxResourceDescription description;
+		std::wstring name;
+		std::vector<uint8_t> memory;  // empty for registered (external) resources
+		bool external = false;
+		bool alive = true;
+	};
+
+	struct Pipeline
+	{
+		FfxFsr2Pass passId;
+		uint32_t contextFlags;
+		std::vector<FfxFilterType> samplers;
+		std::vector<uint32_t> rootConstantBufferSizes;
+		bool alive = true;
+	};
+
+	struct ExecutedJob
+	{
+		FfxCommandList commandList;
+		uint64_t submission;  // index of the ffxFsr2ExecuteGpuJobs call that ran the job
+		FfxGpuJobDescription job;
+	};
+
+	// Backend state, placement-constructed in the interface scratch buffer like the real backends.
+	struct BackendContext
+	{
+		FfxDevice device = nullptr;
+		std::vector<Resource> resources;  // indexed by FfxResourceInternal::internalIndex
+		size_t staticResourceCount = 0;
+		std::vector<Pipeline> pipelines;  // FfxPipeline handle is index + 1
+		std::vector<FfxGpuJobDescription> queue;
+		std::vector<ExecutedJob> executed;
+		uint64_t submissions = 0;
+		size_t hostBytes = 0;
+	};
+
+	// Returns the backend state behind an interface returned by ffxFsr2GetInterfaceMock, or nullptr before creation.
+	BackendContext* GetBackendContext(const FfxFsr2Interface* backendInterface);
+
+	// Backend contexts alive on a device; like the real backends, each one holds a reference to its device.
+	size_t GetDeviceReferences(FfxDevice device);
+
+	// What a game sets up around one FSR2 context: the mock interface with its own scratch buffer and the
+	// context memory.
+	struct Harness
+	{
+		std::vector<uint8_t> scratch;
+		std::unique_ptr<FfxFsr2Context> context = std::make_unique<FfxFsr2Context>();
+
+		Harness();
+
+		FfxFsr2ContextDescription MakeContextDescription(FfxDimensions2D maxRenderSize, FfxDimensions2D displaySize, FfxDevice device, uint32_t flags = 0);
+	};
+
+	// A dispatch with every input registered, the way the game submits it.
+	FfxFsr2DispatchDescription MakeDispatchDescription(FfxDimensions2D renderSize);
+}
+
+size_t ffxFsr2GetScratchMemorySizeMock();
+
+FfxErrorCode ffxFsr2GetInterfaceMock(FfxFsr2Interface* outInterface, void* scratchBuffer, size_t scratchBufferSize);
+
+// Stand-ins for the SDK entry points the game calls. The private state starts with a copy of the
+// context description, like the real runtime, and every callback goes through that copy.
+FfxErrorCode ffxFsr2ContextCreateMock(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription);
+FfxErrorCode ffxFsr2ContextDispatchMock(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchDescription);
+FfxErrorCode ffxFsr2ContextDestroyMock(FfxFsr2Context* context);
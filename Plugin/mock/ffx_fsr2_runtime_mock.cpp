@@ -0,0 +1,242 @@
+#include "ffx_fsr2_mock.h"
+
+#include <cstring>
+#include <cwchar>
+#include <iterator>
+
+namespace
+{
+	enum class SizeClass
+	{
+		Render,
+		Display,
+		Fixed
+	};
+
+	struct InternalResource
+	{
+		const wchar_t* name;
+		FfxSurfaceFormat format;
+		SizeClass size;
+		uint32_t mipCount;
+		bool history;  // cleared on the first dispatch and on reset
+	};
+
+	// The internal resources FSR2 2.2 allocates, close enough in count, format and size to make memory accounting realistic
+	constexpr InternalResource InternalResources[] = {
+		{ L"FSR2_ReconstructedPrevNearestDepth", FFX_SURFACE_FORMAT_R32_UINT, SizeClass::Render, 1, false },
+		{ L"FSR2_DilatedDepth", FFX_SURFACE_FORMAT_R32_FLOAT, SizeClass::Render, 1, false },
+		{ L"FSR2_DilatedVelocity", FFX_SURFACE_FORMAT_R16G16_FLOAT, SizeClass::Render, 1, false },
+		{ L"FSR2_PreparedInputColor", FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, SizeClass::Render, 1, false },
+		{ L"FSR2_LockStatus1", FFX_SURFACE_FORMAT_R16G16_FLOAT, SizeClass::Display, 1, true },
+		{ L"FSR2_LockStatus2", FFX_SURFACE_FORMAT_R16G16_FLOAT, SizeClass::Display, 1, true },
+		{ L"FSR2_InternalUpscaled1", FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, SizeClass::Display, 1, true },
+		{ L"FSR2_InternalUpscaled2", FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, SizeClass::Display, 1, true },
+		{ L"FSR2_LumaHistory1", FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, SizeClass::Display, 1, true },
+		{ L"FSR2_LumaHistory2", FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, SizeClass::Display, 1, true },
+		{ L"FSR2_ExposureMips", FFX_SURFACE_FORMAT_R16_FLOAT, SizeClass::Render, 0, false },
+		{ L"FSR2_Exposure", FFX_SURFACE_FORMAT_R32G32_FLOAT, SizeClass::Fixed, 1, true },
+		{ L"FSR2_LanczosLutData", FFX_SURFACE_FORMAT_R16_SNORM, SizeClass::Fixed, 1, false },
+	};
+
+	constexpr size_t InternalResourceCount = std::size(InternalResources);
+
+	struct ContextPrivate
+	{
+		FfxFsr2ContextDescription contextDescription;  // must stay first, callbacks receive a pointer into it
+		FfxDeviceCapabilities deviceCapabilities;
+		FfxResourceInternal resources[InternalResourceCount];
+		FfxPipelineState pipelines[FFX_FSR2_PASS_COUNT];
+		bool pipelineCreated[FFX_FSR2_PASS_COUNT];
+		uint32_t frameIndex;
+		bool firstExecution;
+	};
+
+	static_assert(sizeof(ContextPrivate) <= sizeof(FfxFsr2Context));
+
+	constexpr uint32_t ConstantBufferSize = 54;
+
+	FfxFsr2Interface* GetCallbacks(ContextPrivate* context)
+	{
+		return &context->contextDescription.callbacks;
+	}
+
+	void Release(ContextPrivate* context)
+	{
+		auto callbacks = GetCallbacks(context);
+
+		for (uint32_t pass = 0; pass < FFX_FSR2_PASS_COUNT; pass++) {
+			if (context->pipelineCreated[pass])
+				callbacks->fpDestroyPipeline(callbacks, &context->pipelines[pass]);
+			context->pipelineCreated[pass] = false;
+		}
+
+		for (auto& resource : context->resources) {
+			if (resource.internalIndex >= 0)
+				callbacks->fpDestroyResource(callbacks, resource);
+			resource.internalIndex = -1;
+		}
+
+		callbacks->fpDestroyBackendContext(callbacks);
+	}
+
+	FfxErrorCode CreatePipeline(ContextPrivate* context, FfxFsr2Pass passId)
+	{
+		FfxFilterType samplers[] = { FFX_FILTER_TYPE_POINT, FFX_FILTER_TYPE_LINEAR };
+		uint32_t rootConstantBufferSizes[] = { ConstantBufferSize, 8 };
+
+		FfxPipelineDescription description{};
+		description.contextFlags = context->contextDescription.flags;
+		description.samplers = samplers;
+		description.samplerCount = std::size(samplers);
+		description.rootConstantBufferSizes = rootConstantBufferSizes;
+		description.rootConstantBufferCount = (passId == FFX_FSR2_PASS_RCAS || passId == FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID) ? 2 : 1;
+
+		auto callbacks = GetCallbacks(context);
+		const auto result = callbacks->fpCreatePipeline(callbacks, passId, &description, &context->pipelines[passId]);
+		context->pipelineCreated[passId] = result == FFX_OK;
+		return result;
+	}
+
+	void ScheduleCompute(ContextPrivate* context, FfxFsr2Pass passId, FfxDimensions2D size)
+	{
+		FfxGpuJobDescription job{};
+		job.jobType = FFX_GPU_JOB_COMPUTE;
+		job.computeJobDescriptor.pipeline = context->pipelines[passId];
+		job.computeJobDescriptor.dimensions[0] = (size.width + 7) / 8;
+		job.computeJobDescriptor.dimensions[1] = (size.height + 7) / 8;
+		job.computeJobDescriptor.dimensions[2] = 1;
+		job.computeJobDescriptor.cbs[0].uint32Size = ConstantBufferSize;
+		job.computeJobDescriptor.cbs[0].data[0] = context->frameIndex;
+
+		auto callbacks = GetCallbacks(context);
+		callbacks->fpScheduleGpuJob(callbacks, &job);
+	}
+}
+
+FfxErrorCode ffxFsr2ContextCreateMock(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription)
+{
+	if (!context || !contextDescription)
+		return FFX_ERROR_INVALID_POINTER;
+
+	std::memset(context, 0, sizeof(FfxFsr2Context));
+
+	auto privateContext = reinterpret_cast<ContextPrivate*>(context);
+	privateContext->contextDescription = *contextDescription;
+	privateContext->firstExecution = true;
+	for (auto& resource : privateContext->resources)
+		resource.internalIndex = -1;
+
+	auto callbacks = GetCallbacks(privateContext);
+
+	auto result = callbacks->fpCreateBackendContext(callbacks, contextDescription->device);
+	if (result != FFX_OK)
+		return result;
+
+	result = callbacks->fpGetDeviceCapabilities(callbacks, &privateContext->deviceCapabilities, contextDescription->device);
+	if (result != FFX_OK) {
+		callbacks->fpDestroyBackendContext(callbacks);
+		return result;
+	}
+
+	for (size_t i = 0; i < InternalResourceCount; i++) {
+		const auto& internal = InternalResources[i];
+
+		FfxCreateResourceDescription description{};
+		description.heapType = FFX_HEAP_TYPE_DEFAULT;
+		description.resourceDescription.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+		description.resourceDescription.format = internal.format;
+		description.resourceDescription.depth = 1;
+		description.resourceDescription.mipCount = internal.mipCount;
+		description.resourceDescription.flags = FFX_RESOURCE_FLAGS_NONE;
+		description.initalState = FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+		description.name = internal.name;
+		description.usage = FFX_RESOURCE_USAGE_UAV;
+		description.id = static_cast<uint32_t>(i);
+
+		const auto size = internal.size == SizeClass::Render ? contextDescription->maxRenderSize : contextDescription->displaySize;
+		description.resourceDescription.width = internal.size == SizeClass::Fixed ? 128 : size.width;
+		description.resourceDescription.height = internal.size == SizeClass::Fixed ? 1 : size.height;
+
+		result = callbacks->fpCreateResource(callbacks, &description, &privateContext->resources[i]);
+		if (result != FFX_OK) {
+			Release(privateContext);
+			return result;
+		}
+	}
+
+	for (uint32_t pass = 0; pass < FFX_FSR2_PASS_COUNT; pass++) {
+		result = CreatePipeline(privateContext, static_cast<FfxFsr2Pass>(pass));
+		if (result != FFX_OK) {
+			Release(privateContext);
+			return result;
+		}
+	}
+
+	return FFX_OK;
+}
+
+FfxErrorCode ffxFsr2ContextDispatchMock(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchDescription)
+{
+	if (!context || !dispatchDescription)
+		return FFX_ERROR_INVALID_POINTER;
+
+	auto privateContext = reinterpret_cast<ContextPrivate*>(context);
+	auto callbacks = GetCallbacks(privateContext);
+
+	const FfxResource* inputs[] = {
+		&dispatchDescription->color,
+		&dispatchDescription->depth,
+		&dispatchDescription->motionVectors,
+		&dispatchDescription->exposure,
+		&dispatchDescription->reactive,
+		&dispatchDescription->transparencyAndComposition,
+		&dispatchDescription->output,
+	};
+	for (auto input : inputs) {
+		FfxResourceInternal registered;
+		callbacks->fpRegisterResource(callbacks, input, &registered);
+	}
+
+	if (privateContext->firstExecution || dispatchDescription->reset) {
+		for (size_t i = 0; i < InternalResourceCount; i++) {
+			if (!InternalResources[i].history)
+				continue;
+
+			FfxGpuJobDescription job{};
+			job.jobType = FFX_GPU_JOB_CLEAR_FLOAT;
+			job.clearJobDescriptor.target = privateContext->resources[i];
+			callbacks->fpScheduleGpuJob(callbacks, &job);
+		}
+	}
+
+	const auto renderSize = dispatchDescription->renderSize;
+	const auto displaySize = privateContext->contextDescription.displaySize;
+
+	ScheduleCompute(privateContext, FFX_FSR2_PASS_COMPUTE_LUMINANCE_PYRAMID, renderSize);
+	ScheduleCompute(privateContext, FFX_FSR2_PASS_RECONSTRUCT_PREVIOUS_DEPTH, renderSize);
+	ScheduleCompute(privateContext, FFX_FSR2_PASS_DEPTH_CLIP, renderSize);
+	ScheduleCompute(privateContext, FFX_FSR2_PASS_LOCK, renderSize);
+	if (dispatchDescription->enableSharpening) {
+		ScheduleCompute(privateContext, FFX_FSR2_PASS_ACCUMULATE_SHARPEN, displaySize);
+		ScheduleCompute(privateContext, FFX_FSR2_PASS_RCAS, displaySize);
+	} else {
+		ScheduleCompute(privateContext, FFX_FSR2_PASS_ACCUMULATE, displaySize);
+	}
+
+	const auto result = callbacks->fpExecuteGpuJobs(callbacks, dispatchDescription->commandList);
+	callbacks->fpUnregisterResources(callbacks);
+
+	privateContext->firstExecution = false;
+	privateContext->frameIndex++;
+	return result;
+}
+
+FfxErrorCode ffxFsr2ContextDestroyMock(FfxFsr2Context* context)
+{
+	if (!context)
+		return FFX_ERROR_INVALID_POINTER;
+
+	Release(reinterpret_cast<ContextPrivate*>(context));
+	return FFX_OK;
+}
@@ -0,0 +1,170 @@
+#include "ABCapture.h"
+
+#include "EventLog.h"
+#include "Qoi.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+#include <nlohmann/json.hpp>
+
+void ABCapture::RecordDispatch(const FfxLayout::DispatchFields& dispatch)
+{
+	metadata.Update([&](Metadata& current) {
+		current.jitterOffset = dispatch.jitterOffset;
+		current.frameTimeDelta = dispatch.frameTimeDelta;
+		current.sharpness = dispatch.sharpness;
+		current.enableSharpening = dispatch.enableSharpening;
+		current.reset = dispatch.reset;
+		current.cameraNear = dispatch.cameraNear;
+		current.cameraFar = dispatch.cameraFar;
+		current.cameraFovAngleVertical = dispatch.cameraFovAngleVertical;
+	});
+}
+
+void ABCapture::RecordBias(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias)
+{
+	metadata.Update([&](Metadata& current) {
+		current.renderSize = renderSize;
+		current.displaySize = displaySize;
+		current.bias = bias;
+	});
+}
+
+void ABCapture::Start(const std::filesystem::path& baseDirectory, uint32_t newPairs, bool forceDisable)
+{
+	if (IsCapturing())
+		return;
+
+	// One directory per sequence so earlier captures are never overwritten
+	const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+	const auto newDirectory = baseDirectory / std::format("{:%Y%m%d_%H%M%S}", now);
+
+	std::error_code error;
+	std::filesystem::create_directories(newDirectory, error);
+	if (error) {
+		ERROR("Failed to create capture directory {}: {}", newDirectory.string(), error.message());
+		return;
+	}
+
+	directory = newDirectory;
+	pairs = newPairs;
+	pair = 0;
+	restoreForceDisable = forceDisable;
+	step = Step::SettleEnabled;
+	wait = SettleFrames;
+
+	if (!queue)
+		queue = Worker::GetSingleton()->CreateQueue("capture");
+
+	INFO("Capturing {} A/B pairs to {}", pairs, directory.string());
+}
+
+void ABCapture::Stop()
+{
+	if (!IsCapturing())
+		return;
+
+	// Advance restores forceDisable when it sees the sequence ended
+	pairs = pair;
+}
+
+void ABCapture::Advance(reshade::api::effect_runtime* runtime, bool& forceDisable)
+{
+	if (step == Step::Idle)
+		return;
+
+	if (pair >= pairs) {
+		step = Step::Idle;
+		forceDisable = restoreForceDisable;
+		INFO("Captured {} A/B pairs", pair);
+		return;
+	}
+
+	switch (step) {
+	case Step::SettleEnabled:
+		forceDisable = false;
+		if (--wait == 0)
+			step = Step::CaptureEnabled;
+		break;
+	case Step::CaptureEnabled:
+		Capture(runtime, false);
+		forceDisable = true;
+		wait = SettleFrames;
+		step = Step::SettleDisabled;
+		break;
+	case Step::SettleDisabled:
+		if (--wait == 0)
+			step = Step::CaptureDisabled;
+		break;
+	case Step::CaptureDisabled:
+		Capture(runtime, true);
+		forceDisable = false;
+		pair++;
+		wait = SettleFrames;
+		step = Step::SettleEnabled;
+		break;
+	default:
+		break;
+	}
+}
+
+void ABCapture::Capture(reshade::api::effect_runtime* runtime, bool forceDisabled)
+{
+	Job job;
+	runtime->get_screenshot_width_and_height(&job.width, &job.height);
+	job.pixels.resize(size_t(job.width) * job.height * 4);
+	if (!runtime->capture_screenshot(job.pixels.data())) {
+		EventLog::GetSingleton()->Post<EventLog::Event::ScreenshotFailed>(pair);
+		return;
+	}
+
+	job.metadata = metadata.Load();
+	job.pair = pair;
+	job.forceDisabled = forceDisabled;
+	job.path = directory / std::format("pair_{:03}_{}", pair, forceDisabled ? 'b' : 'a');
+
+	if (!queue)
+		Write(job);
+	else if (!queue->Post([job = std::make_unique<Job>(std::move(job))] { Write(*job); }))
+		ERROR("Capture queue is full, dropped pair {}", pair);
+}
+
+void ABCapture::Write(const Job& job)
+{
+	const auto encoded = Qoi::Encode(job.pixels.data(), job.width, job.height);
+
+	auto imagePath = job.path;
+	imagePath += L".qoi";
+	std::ofstream image(imagePath, std::ios::binary | std::ios::trunc);
+	image.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+	if (!image) {
+		ERROR("Failed to write {}", imagePath.string());
+		return;
+	}
+
+	const auto& metadata = job.metadata;
+	nlohmann::json json = {
+		{ "pair", job.pair },
+		{ "force_disabled", job.forceDisabled },
+		{ "width", job.width },
+		{ "height", job.height },
+		{ "render_size", { metadata.renderSize.width, metadata.renderSize.height } },
+		{ "display_size", { metadata.displaySize.width, metadata.displaySize.height } },
+		{ "bias", metadata.bias },
+		{ "jitter_offset", { metadata.jitterOffset.x, metadata.jitterOffset.y } },
+		{ "frame_time_delta", metadata.frameTimeDelta },
+		{ "enable_sharpening", metadata.enableSharpening },
+		{ "sharpness", metadata.sharpness },
+		{ "reset", metadata.reset },
+		{ "camera_near", metadata.cameraNear },
+		{ "camera_far", metadata.cameraFar },
+		{ "camera_fov_angle_vertical", metadata.cameraFovAngleVertical },
+	};
+
+	auto metadataPath = job.path;
+	metadataPath += L".json";
+	std::ofstream file(metadataPath, std::ios::trunc);
+	file << json.dump(1, '\t');
+}
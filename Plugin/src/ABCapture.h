@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FfxLayout.h"
+#include "SeqLock.h"
+#include "Worker.h"
+
+namespace reshade::api
+{
+	struct effect_runtime;
+}
+
+// Captures pairs of screenshots with the fix applied and force-disabled, for tuning the bias formula on
+// image metrics instead of by eye. The game applies a new bias with some latency, so a few frames are left
+// to settle after every switch. Pixels are encoded as QOI on the worker, each next to a JSON file
+// with the dispatch parameters it was rendered with. tools/capture_diff compares the pairs.
+class ABCapture
+{
+public:
+	static ABCapture* GetSingleton()
+	{
+		static ABCapture singleton;
+		return &singleton;
+	}
+
+	static constexpr uint32_t SettleFrames = 3;
+	static constexpr uint32_t DefaultPairs = 8;
+
+	// Called from the dispatch hook and whenever the bias is evaluated. Neither blocks, Capture reads a
+	// snapshot on present.
+	void RecordDispatch(const FfxLayout::DispatchFields& dispatch);
+	void RecordBias(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias);
+
+	void Start(const std::filesystem::path& baseDirectory, uint32_t pairs, bool forceDisable);
+	void Stop();
+	bool IsCapturing() const { return step != Step::Idle; }
+	uint32_t GetCapturedPairs() const { return pair; }
+
+	// Called once per presented frame, before the bias for the next frame is applied.
+	// Switches forceDisable as the sequence requires.
+	void Advance(reshade::api::effect_runtime* runtime, bool& forceDisable);
+
+private:
+	enum class Step
+	{
+		Idle,
+		SettleEnabled,
+		CaptureEnabled,
+		SettleDisabled,
+		CaptureDisabled
+	};
+
+	struct Metadata
+	{
+		FfxDimensions2D renderSize{};
+		FfxDimensions2D displaySize{};
+		FfxFloatCoords2D jitterOffset{};
+		float bias = 0.0f;
+		float frameTimeDelta = 0.0f;
+		float sharpness = 0.0f;
+		bool enableSharpening = false;
+		bool reset = false;
+		float cameraNear = 0.0f;
+		float cameraFar = 0.0f;
+		float cameraFovAngleVertical = 0.0f;
+	};
+
+	struct Job
+	{
+		std::filesystem::path path;  // without extension
+		std::vector<uint8_t> pixels;
+		uint32_t width;
+		uint32_t height;
+		Metadata metadata;
+		uint32_t pair;
+		bool forceDisabled;
+	};
+
+	ABCapture() = default;
+
+	void Capture(reshade::api::effect_runtime* runtime, bool forceDisabled);
+	static void Write(const Job& job);
+
+	SeqLock<Metadata> metadata;
+
+	// Present thread
+	Step step = Step::Idle;
+	uint32_t wait = 0;
+	uint32_t pair = 0;
+	uint32_t pairs = 0;
+	bool restoreForceDisable = false;
+	std::filesystem::path directory;
+	Worker::Queue* queue = nullptr;
+};
@@ -0,0 +1,62 @@
+#include "BiasPublisher.h"
+
+#include "Metrics.h"
+#include "Worker.h"
+
+namespace
+{
+	Metrics::Counter biasChanges{ "bias.changes" };
+	Metrics::Gauge currentBias{ "bias.value" };
+}
+
+void BiasPublisher::SetTarget(float* newTarget)
+{
+	target = newTarget;
+	if (newTarget)
+		bias.store(*newTarget, std::memory_order_relaxed);
+}
+
+bool BiasPublisher::Publish(float newBias)
+{
+	auto setting = target.load(std::memory_order_relaxed);
+	if (!setting)
+		return false;
+
+	// Compare against the setting itself rather than the cached value, in case the game reloaded its INI
+	if (*setting == newBias)
+		return false;
+
+	*setting = newBias;
+	bias.store(newBias, std::memory_order_relaxed);
+	version.fetch_add(1, std::memory_order_release);
+	biasChanges.Add();
+	currentBias.Set(newBias);
+	return true;
+}
+
+void BiasPublisher::Subscribe(Subscriber subscriber)
+{
+	std::lock_guard guard(lock);
+	subscribers.push_back(std::move(subscriber));
+
+	if (!notifierStarted) {
+		notifierStarted = true;
+		Worker::GetSingleton()->Every(NotifyInterval, [this] { Notify(); });
+	}
+}
+
+void BiasPublisher::Notify()
+{
+	const auto current = version.load(std::memory_order_acquire);
+	if (current == notified)
+		return;
+	notified = current;
+
+	std::unique_lock guard(lock);
+	const float currentBias = bias.load(std::memory_order_relaxed);
+	const auto snapshot = subscribers;
+	guard.unlock();
+
+	for (auto& subscriber : snapshot)
+		subscriber(currentBias, current);
+}
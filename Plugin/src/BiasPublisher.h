@@ -0,0 +1,44 @@
+#pragma once
+
+// Owns writes to the game's fMipBias setting. The value is only committed when it actually changes, so
+// the settings block other game threads read from is not dirtied every frame. Each committed change
+// bumps a version number and is handed to subscribers from a periodic worker task, never on the render
+// thread that published it. Subscribers are coalesced: a burst of changes is delivered as the latest
+// value only.
+class BiasPublisher
+{
+public:
+	static BiasPublisher* GetSingleton()
+	{
+		static BiasPublisher singleton;
+		return &singleton;
+	}
+
+	using Subscriber = std::function<void(float bias, uint64_t version)>;
+
+	void SetTarget(float* target);
+
+	// Returns true if the value changed and was written to the game setting.
+	bool Publish(float bias);
+
+	void Subscribe(Subscriber subscriber);
+
+	float GetBias() const { return bias.load(std::memory_order_relaxed); }
+	uint64_t GetVersion() const { return version.load(std::memory_order_acquire); }
+
+private:
+	BiasPublisher() = default;
+
+	static constexpr auto NotifyInterval = std::chrono::milliseconds(10);
+
+	void Notify();
+
+	std::atomic<float*> target = nullptr;
+	std::atomic<float> bias = 0.0f;
+	std::atomic<uint64_t> version = 0;
+
+	std::mutex lock;
+	std::vector<Subscriber> subscribers;
+	bool notifierStarted = false;
+	uint64_t notified = 0;  // worker only
+};
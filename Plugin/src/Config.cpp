@@ -0,0 +1,69 @@
+#include "Config.h"
+
+#include "Worker.h"
+
+void Config::Start(std::filesystem::path newPath)
+{
+	path = std::move(newPath);
+
+	std::error_code error;
+	lastWrite = std::filesystem::last_write_time(path, error);
+	if (error)
+		INFO("No {}, using default settings", path.string());
+	else
+		Load();
+
+	Worker::GetSingleton()->Every(PollInterval, [this] { CheckForChanges(); });
+}
+
+void Config::Subscribe(Subscriber subscriber)
+{
+	std::lock_guard guard(lock);
+	subscribers.push_back(std::move(subscriber));
+}
+
+bool Config::Load()
+{
+	auto settings = std::make_unique<Settings>();
+	if (!Parse(*settings))
+		return false;
+
+	if (!std::isfinite(settings->bias.scale) || !std::isfinite(settings->bias.offset) || !std::isfinite(settings->bias.minBias) || !std::isfinite(settings->bias.maxBias) || settings->bias.minBias > settings->bias.maxBias) {
+		ERROR("Invalid bias settings in {} (scale {} offset {} min {} max {}), keeping the previous settings", path.string(), settings->bias.scale, settings->bias.offset, settings->bias.minBias, settings->bias.maxBias);
+		return false;
+	}
+
+	INFO("Loaded {}: bias = {} * log2(render / display) + {} in [{}, {}], {}", path.string(), settings->bias.scale, settings->bias.offset, settings->bias.minBias, settings->bias.maxBias, settings->enabled ? "enabled" : "disabled");
+	for (const auto& profile : settings->profiles.GetProfiles())
+		INFO("Profile {}: bias offset {}", profile.name, profile.biasOffset);
+	Publish(std::move(settings));
+	return true;
+}
+
+void Config::Publish(std::unique_ptr<Settings> settings)
+{
+	std::lock_guard guard(lock);
+
+	const auto published = snapshots.Publish(std::move(settings));
+	reloads.fetch_add(1, std::memory_order_relaxed);
+
+	for (auto& subscriber : subscribers)
+		subscriber(*published);
+}
+
+void Config::CheckForChanges()
+{
+	{
+		std::lock_guard guard(lock);
+		snapshots.Reclaim();
+	}
+
+	std::error_code error;
+	const auto write = std::filesystem::last_write_time(path, error);
+	if (error || write == lastWrite)
+		return;
+
+	// Editors may still be writing; a half written file fails to parse and is retried on the next change
+	lastWrite = write;
+	Load();
+}
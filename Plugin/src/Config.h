@@ -0,0 +1,74 @@
+#pragma once
+
+#include "BiasMath.h"
+#include "ProfileTable.h"
+#include "SnapshotCell.h"
+
+// Settings loaded from UpscalingFix.toml next to the plugin. A periodic worker task watches the file and
+// parses every change into a new immutable Settings snapshot, published through a SnapshotCell, so readers
+// on the dispatch and present paths never wait on a reload. A snapshot stays valid for as long as the
+// guard Get returned is alive; the same task frees replaced snapshots once no guard can still see them.
+class Config
+{
+public:
+	static Config* GetSingleton()
+	{
+		static Config singleton;
+		return &singleton;
+	}
+
+	struct Settings
+	{
+		BiasFormula bias;
+
+		bool enabled = true;
+		bool resolutionDetection = true;
+
+		// Initial state of the switches the overlay can also change
+		bool samplerBias = false;
+		bool geometryPassesOnly = true;
+		bool hookTelemetry = false;
+		bool binaryEventLog = false;
+		bool metricsFile = false;
+
+		ProfileTable profiles;
+	};
+
+	using Subscriber = std::function<void(const Settings& settings)>;
+
+	using ReadGuard = SnapshotCell<Settings>::ReadGuard;
+
+	// Keep the guard for as long as anything read from the snapshot is used.
+	ReadGuard Get() { return snapshots.Read(); }
+
+	// Loads the file if it exists and starts watching it.
+	void Start(std::filesystem::path path);
+
+	// Called with every snapshot published from now on, on the thread that loaded it.
+	void Subscribe(Subscriber subscriber);
+
+	uint64_t GetReloads() const { return reloads.load(std::memory_order_relaxed); }
+
+private:
+	Config() = default;
+
+	bool Load();
+
+	// Reads the file over the defaults, in ConfigFile.cpp so everything else builds without toml++
+	bool Parse(Settings& settings) const;
+	void Publish(std::unique_ptr<Settings> settings);
+	void CheckForChanges();
+
+	static constexpr auto PollInterval = std::chrono::milliseconds(500);
+
+	const Settings defaults;
+	SnapshotCell<Settings> snapshots{ &defaults };
+	std::atomic<uint64_t> reloads = 0;
+
+	std::mutex lock;  // the snapshot writer side and subscribers
+	std::vector<Subscriber> subscribers;
+
+	// Worker only after Start
+	std::filesystem::path path;
+	std::filesystem::file_time_type lastWrite;
+};
@@ -0,0 +1,82 @@
+#include "Config.h"
+
+#include <toml++/toml.h>
+
+namespace
+{
+	bool LoadProfiles(const toml::table& file, ProfileTable& profiles)
+	{
+		auto array = file["profile"].as_array();
+		if (!array)
+			return true;
+
+		for (const auto& node : *array) {
+			auto table = node.as_table();
+			if (!table)
+				continue;
+
+			std::string name((*table)["name"].value_or(std::string_view("unnamed")));
+			const float offset = (*table)["offset"].value_or(0.0f);
+
+			if (const auto scale = (*table)["scale"].value<float>()) {
+				if (!profiles.AddScale(name, offset, *scale, (*table)["tolerance"].value_or(0.01f))) {
+					ERROR("Profile {} has an invalid scale or tolerance", name);
+					return false;
+				}
+				continue;
+			}
+
+			const auto render = (*table)["render"];
+			const auto display = (*table)["display"];
+			const auto renderWidth = render[0].value<uint32_t>(), renderHeight = render[1].value<uint32_t>();
+			const auto displayWidth = display[0].value<uint32_t>(), displayHeight = display[1].value<uint32_t>();
+			if (!renderWidth || !renderHeight || !displayWidth || !displayHeight) {
+				ERROR("Profile {} needs either a scale or render and display resolutions", name);
+				return false;
+			}
+
+			if (!profiles.AddPair(name, offset, *renderWidth, *renderHeight, *displayWidth, *displayHeight)) {
+				ERROR("Profile {} has a resolution above {} or repeats the resolutions of an earlier profile", name, ProfileTable::MaxDimension);
+				return false;
+			}
+		}
+
+		if (!profiles.Compile()) {
+			ERROR("Failed to compile {} profiles", profiles.GetProfiles().size());
+			return false;
+		}
+		return true;
+	}
+}
+
+bool Config::Parse(Settings& settings) const
+{
+	try {
+		auto file = toml::parse_file(path.string());
+
+		auto bias = file["bias"];
+		settings.bias.scale = bias["scale"].value_or(settings.bias.scale);
+		settings.bias.offset = bias["offset"].value_or(settings.bias.offset);
+		settings.bias.minBias = bias["min"].value_or(settings.bias.minBias);
+		settings.bias.maxBias = bias["max"].value_or(settings.bias.maxBias);
+
+		auto features = file["features"];
+		settings.enabled = features["enabled"].value_or(settings.enabled);
+		settings.resolutionDetection = features["resolution_detection"].value_or(settings.resolutionDetection);
+		settings.samplerBias = features["sampler_bias"].value_or(settings.samplerBias);
+		settings.geometryPassesOnly = features["geometry_passes_only"].value_or(settings.geometryPassesOnly);
+		settings.hookTelemetry = features["hook_telemetry"].value_or(settings.hookTelemetry);
+		settings.binaryEventLog = features["binary_event_log"].value_or(settings.binaryEventLog);
+		settings.metricsFile = features["metrics_file"].value_or(settings.metricsFile);
+
+		if (!LoadProfiles(file, settings.profiles)) {
+			ERROR("Invalid profiles in {}, keeping the previous settings", path.string());
+			return false;
+		}
+	} catch (const toml::parse_error& error) {
+		ERROR("Failed to parse {} at line {}: {}, keeping the previous settings", path.string(), error.source().begin.line, error.description());
+		return false;
+	}
+
+	return true;
+}
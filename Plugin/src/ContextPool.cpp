@@ -0,0 +1,237 @@
+#include "ContextPool.h"
+
+#include "FfxUtil.h"
+#include "PipelineCache.h"
+
+FfxErrorCode ContextPool::Create(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription, CreateFunc original)
+{
+	if (!context || !contextDescription)
+		return original(context, contextDescription);
+
+	std::lock_guard guard(lock);
+
+	const Key key{ contextDescription->device, contextDescription->flags, contextDescription->maxRenderSize, contextDescription->displaySize };
+
+	// Memory that is created into again without a destroy no longer runs the old entry
+	for (auto& entry : entries) {
+		if (entry.boundContext == context)
+			entry.boundContext = nullptr;
+	}
+
+	// The game moved on to another device, idle entries of the old one would only keep it alive
+	ReleaseIdle([&](const Entry& entry) { return entry.key.device != key.device; });
+
+	for (auto it = entries.begin(); it != entries.end(); ++it) {
+		if (it->boundContext || !(it->key == key))
+			continue;
+
+		entries.splice(entries.begin(), entries, it);
+		std::memcpy(context, it->snapshot.get(), sizeof(FfxFsr2Context));
+		it->boundContext = context;
+		pendingReset.store(context, std::memory_order_relaxed);
+
+		INFO("Reusing pooled FSR2 context {}x{} -> {}x{} flags {:X}", key.maxRenderSize.width, key.maxRenderSize.height, key.displaySize.width, key.displaySize.height, key.flags);
+		return FFX_OK;
+	}
+
+	backend = contextDescription->callbacks;
+
+	auto& entry = entries.emplace_front();
+	entry.key = key;
+	entry.callbacks = contextDescription->callbacks;
+	if (contextDescription->callbacks.scratchBufferSize) {
+		entry.scratch = std::make_unique<uint8_t[]>(contextDescription->callbacks.scratchBufferSize);
+		entry.callbacks.scratchBuffer = entry.scratch.get();
+	}
+	entry.boundContext = context;
+
+	FfxFsr2ContextDescription pooledDescription = *contextDescription;
+	pooledDescription.callbacks = entry.callbacks;
+	pooledDescription.callbacks.fpCreateBackendContext = &CreateBackendContext_hook;
+	pooledDescription.callbacks.fpCreateResource = &CreateResource_hook;
+	pooledDescription.callbacks.fpDestroyResource = &DestroyResource_hook;
+	pooledDescription.callbacks.fpCreatePipeline = &CreatePipeline_hook;
+	pooledDescription.callbacks.fpDestroyPipeline = &DestroyPipeline_hook;
+	pooledDescription.callbacks.fpDestroyBackendContext = &DestroyBackendContext_hook;
+
+	const auto result = original(context, &pooledDescription);
+	entry.creating = false;
+	if (result != FFX_OK) {
+		// The SDK unwound through the hooks below, which keep everything for the pool, so what it created
+		// is still alive and released here
+		Release(entry);
+		entries.pop_front();
+		return result;
+	}
+
+	entry.snapshot = std::make_unique<FfxFsr2Context>(*context);
+
+	INFO("Created pooled FSR2 context {}x{} -> {}x{} flags {:X} ({} MiB, {} MiB pooled)", key.maxRenderSize.width, key.maxRenderSize.height, key.displaySize.width, key.displaySize.height, key.flags, entry.bytes >> 20, pooledBytes >> 20);
+
+	EvictIdle();
+	return result;
+}
+
+ContextPool::Entry* ContextPool::FindBound(FfxFsr2Interface* backendInterface)
+{
+	for (auto& entry : entries) {
+		if (entry.boundContext && FfxUtil::GetInterface(entry.boundContext) == backendInterface)
+			return &entry;
+	}
+	return nullptr;
+}
+
+void ContextPool::Release(Entry& entry)
+{
+	for (auto& resource : entry.resources)
+		entry.callbacks.fpDestroyResource(&entry.callbacks, resource);
+
+	// Cached pipelines are shared by the device's entries, the last one takes them along while its backend
+	// is still alive to destroy them
+	const bool lastOfDevice = std::ranges::none_of(entries, [&](const Entry& other) { return &other != &entry && other.key.device == entry.key.device; });
+	if (lastOfDevice && entry.backendCreated)
+		PipelineCache::GetSingleton()->Flush(entry.key.device, &entry.callbacks, entry.callbacks.fpDestroyPipeline);
+
+	if (entry.backendCreated)
+		entry.callbacks.fpDestroyBackendContext(&entry.callbacks);
+
+	pooledBytes -= entry.bytes;
+}
+
+void ContextPool::ReleaseIdle(auto&& predicate)
+{
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (it->boundContext || it->creating || !predicate(*it)) {
+			++it;
+			continue;
+		}
+
+		INFO("Releasing pooled FSR2 context {}x{} -> {}x{} flags {:X}", it->key.maxRenderSize.width, it->key.maxRenderSize.height, it->key.displaySize.width, it->key.displaySize.height, it->key.flags);
+		Release(*it);
+		it = entries.erase(it);
+	}
+}
+
+void ContextPool::ReleaseDevice(FfxDevice device)
+{
+	std::lock_guard guard(lock);
+	ReleaseIdle([&](const Entry& entry) { return entry.key.device == device; });
+}
+
+void ContextPool::ReleaseAll()
+{
+	std::lock_guard guard(lock);
+	ReleaseIdle([](const Entry&) { return true; });
+}
+
+void ContextPool::EvictIdle()
+{
+	size_t idle = 0;
+	for (auto& entry : entries) {
+		if (!entry.boundContext)
+			idle++;
+	}
+
+	for (auto it = entries.end(); it != entries.begin() && (pooledBytes > MaxPoolBytes || idle > MaxIdleContexts);) {
+		--it;
+		if (it->boundContext || it->creating)
+			continue;
+
+		INFO("Evicting pooled FSR2 context {}x{} -> {}x{} flags {:X} ({} MiB, {} MiB pooled, {} idle)", it->key.maxRenderSize.width, it->key.maxRenderSize.height, it->key.displaySize.width, it->key.displaySize.height, it->key.flags, it->bytes >> 20, pooledBytes >> 20, idle);
+
+		Release(*it);
+		it = entries.erase(it);
+		idle--;
+	}
+}
+
+FfxErrorCode ContextPool::CreateBackendContext_hook(FfxFsr2Interface* backendInterface, FfxDevice device)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	auto entry = pool->FindBound(backendInterface);
+	if (!entry)
+		return pool->backend.fpCreateBackendContext(backendInterface, device);
+
+	const auto result = entry->callbacks.fpCreateBackendContext(backendInterface, device);
+	entry->backendCreated = result == FFX_OK;
+	return result;
+}
+
+FfxErrorCode ContextPool::CreateResource_hook(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outResource)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	auto entry = pool->FindBound(backendInterface);
+	if (!entry)
+		return pool->backend.fpCreateResource(backendInterface, createResourceDescription, outResource);
+
+	const auto result = entry->callbacks.fpCreateResource(backendInterface, createResourceDescription, outResource);
+	if (result == FFX_OK) {
+		const auto bytes = FfxUtil::EstimateResourceSize(createResourceDescription->resourceDescription);
+		entry->resources.push_back(*outResource);
+		entry->bytes += bytes;
+		pool->pooledBytes += bytes;
+	}
+	return result;
+}
+
+FfxErrorCode ContextPool::DestroyResource_hook(FfxFsr2Interface* backendInterface, FfxResourceInternal resource)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	// Resources of pooled contexts stay alive until the entry is evicted
+	if (pool->FindBound(backendInterface))
+		return FFX_OK;
+	return pool->backend.fpDestroyResource(backendInterface, resource);
+}
+
+FfxErrorCode ContextPool::CreatePipeline_hook(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	auto entry = pool->FindBound(backendInterface);
+	if (!entry)
+		return pool->backend.fpCreatePipeline(backendInterface, passId, pipelineDescription, outPipeline);
+
+	return PipelineCache::GetSingleton()->Create(backendInterface, entry->key.device, passId, pipelineDescription, outPipeline, entry->callbacks.fpCreatePipeline);
+}
+
+FfxErrorCode ContextPool::DestroyPipeline_hook(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	// Pipelines of pooled contexts belong to the PipelineCache
+	if (pool->FindBound(backendInterface))
+		return FFX_OK;
+	return pool->backend.fpDestroyPipeline(backendInterface, pipeline);
+}
+
+FfxErrorCode ContextPool::DestroyBackendContext_hook(FfxFsr2Interface* backendInterface)
+{
+	auto pool = GetSingleton();
+	std::lock_guard guard(pool->lock);
+
+	auto entry = pool->FindBound(backendInterface);
+	if (!entry)
+		return pool->backend.fpDestroyBackendContext(backendInterface);
+
+	// A failing create is cleaned up by Create once the SDK returns
+	if (entry->creating)
+		return FFX_OK;
+
+	// This is the last call of ffxFsr2ContextDestroy, the game is done with its memory
+	auto context = entry->boundContext;
+	pool->pendingReset.compare_exchange_strong(context, nullptr, std::memory_order_relaxed);
+	entry->boundContext = nullptr;
+
+	INFO("Returned FSR2 context {}x{} -> {}x{} to pool", entry->key.maxRenderSize.width, entry->key.maxRenderSize.height, entry->key.displaySize.width, entry->key.displaySize.height);
+
+	pool->EvictIdle();
+	return FFX_OK;
+}
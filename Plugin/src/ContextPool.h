@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ffx_fsr2.h"
+
+// Keeps FSR2 contexts alive after the game destroys them, so switching back to a recently used
+// (device, maxRenderSize, displaySize, flags) combination reuses the existing context instead of recompiling
+// pipelines and reallocating every internal resource.
+//
+// Every pooled context gets its own backend scratch buffer, and the destroy callbacks are wrapped so
+// that the game's ffxFsr2ContextDestroy only returns the context to the pool. A snapshot of the freshly
+// created context is copied back into the game's memory on reuse, followed by a history reset.
+// Pipelines are not owned by the pool but by the PipelineCache, which shares them between entries of a
+// device and is flushed for that device when its last entry is released.
+//
+// Pooled backends hold a reference to their device, so the device outlives the game's own release of it
+// for as long as they are pooled and no destroy_device event arrives before the pool lets go. Idle entries
+// of a device are released instead when the game creates a context on another device, keyed on the
+// FfxDevice the game passes in, and everything idle is released when the plugin is unloaded.
+class ContextPool
+{
+public:
+	static ContextPool* GetSingleton()
+	{
+		static ContextPool singleton;
+		return &singleton;
+	}
+
+	using CreateFunc = FfxErrorCode (*)(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription);
+
+	static constexpr size_t MaxPoolBytes = 768ull << 20;
+	static constexpr size_t MaxIdleContexts = 3;
+
+	FfxErrorCode Create(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription, CreateFunc original);
+
+	// Returns true once for the first dispatch of a context that was handed out from the pool.
+	bool ConsumeReset(FfxFsr2Context* context)
+	{
+		if (pendingReset.load(std::memory_order_relaxed) != context)
+			return false;
+		return pendingReset.exchange(nullptr, std::memory_order_relaxed) == context;
+	}
+
+	// Releases every idle context of a device, and with the last one its pipelines.
+	void ReleaseDevice(FfxDevice device);
+
+	// Releases every idle context of every device.
+	void ReleaseAll();
+
+	size_t GetPooledBytes() const { return pooledBytes; }
+
+private:
+	struct Key
+	{
+		FfxDevice device;
+		uint32_t flags;
+		FfxDimensions2D maxRenderSize;
+		FfxDimensions2D displaySize;
+
+		bool operator==(const Key& other) const
+		{
+			return device == other.device && flags == other.flags &&
+			       maxRenderSize.width == other.maxRenderSize.width && maxRenderSize.height == other.maxRenderSize.height &&
+			       displaySize.width == other.displaySize.width && displaySize.height == other.displaySize.height;
+		}
+	};
+
+	struct Entry
+	{
+		Key key;
+		FfxFsr2Interface callbacks;  // unwrapped backend callbacks bound to this entry's scratch buffer
+		std::unique_ptr<uint8_t[]> scratch;
+		std::unique_ptr<FfxFsr2Context> snapshot;
+		std::vector<FfxResourceInternal> resources;
+		size_t bytes = 0;
+		FfxFsr2Context* boundContext = nullptr;  // game memory currently running this entry, nullptr while idle
+		bool creating = true;                    // until the original create returned
+		bool backendCreated = false;
+	};
+
+	ContextPool() = default;
+
+	Entry* FindBound(FfxFsr2Interface* backendInterface);
+	void Release(Entry& entry);
+	void ReleaseIdle(auto&& predicate);
+	void EvictIdle();
+
+	static FfxErrorCode CreateBackendContext_hook(FfxFsr2Interface* backendInterface, FfxDevice device);
+	static FfxErrorCode CreateResource_hook(FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outResource);
+	static FfxErrorCode DestroyResource_hook(FfxFsr2Interface* backendInterface, FfxResourceInternal resource);
+	static FfxErrorCode CreatePipeline_hook(FfxFsr2Interface* backendInterface, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline);
+	static FfxErrorCode DestroyPipeline_hook(FfxFsr2Interface* backendInterface, FfxPipelineState* pipeline);
+	static FfxErrorCode DestroyBackendContext_hook(FfxFsr2Interface* backendInterface);
+
+	std::recursive_mutex lock;
+	std::list<Entry> entries;  // most recently used first
+	FfxFsr2Interface backend{};
+	size_t pooledBytes = 0;
+	std::atomic<FfxFsr2Context*> pendingReset = nullptr;
+};
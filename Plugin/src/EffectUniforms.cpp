@@ -0,0 +1,127 @@
+#include "EffectUniforms.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+using namespace reshade::api;
+
+namespace
+{
+	struct SourceName
+	{
+		std::string_view name;
+		EffectUniforms::Source source;
+	};
+
+	constexpr SourceName SourceNames[] = {
+		{ "fsr2_render_size", EffectUniforms::Source::RenderSize },
+		{ "fsr2_display_size", EffectUniforms::Source::DisplaySize },
+		{ "fsr2_scale", EffectUniforms::Source::Scale },
+		{ "fsr2_jitter", EffectUniforms::Source::Jitter },
+		{ "fsr2_bias", EffectUniforms::Source::Bias },
+		{ "fsr2_active", EffectUniforms::Source::Active },
+	};
+
+	static_assert(std::size(SourceNames) == size_t(EffectUniforms::Source::Count));
+
+	void OnReloadedEffects(effect_runtime* runtime)
+	{
+		EffectUniforms::GetSingleton()->Reload(runtime);
+	}
+
+	void OnBeginEffects(effect_runtime* runtime, command_list*, resource_view, resource_view)
+	{
+		EffectUniforms::GetSingleton()->Apply(runtime);
+	}
+
+	void OnDestroyEffectRuntime(effect_runtime* runtime)
+	{
+		EffectUniforms::GetSingleton()->Forget(runtime);
+	}
+}
+
+void EffectUniforms::Register()
+{
+	reshade::register_event<reshade::addon_event::reshade_reloaded_effects>(&OnReloadedEffects);
+	reshade::register_event<reshade::addon_event::reshade_begin_effects>(&OnBeginEffects);
+	reshade::register_event<reshade::addon_event::destroy_effect_runtime>(&OnDestroyEffectRuntime);
+}
+
+void EffectUniforms::Update(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias)
+{
+	state.Update([&](State& current) {
+		current.renderSize = renderSize;
+		current.displaySize = displaySize;
+		current.bias = bias;
+	});
+}
+
+void EffectUniforms::UpdateJitter(FfxFloatCoords2D jitter)
+{
+	const auto currentFrame = frame.load(std::memory_order_relaxed);
+	state.Update([&](State& current) {
+		current.jitter = jitter;
+		current.dispatchFrame = currentFrame;
+	});
+}
+
+void EffectUniforms::Reload(effect_runtime* newRuntime)
+{
+	runtime = newRuntime;
+	uniforms.clear();
+
+	runtime->enumerate_uniform_variables(nullptr, [this](effect_runtime* runtime, effect_uniform_variable variable) {
+		char value[64];
+		size_t length = sizeof(value);
+		if (!runtime->get_annotation_string_from_uniform_variable(variable, "source", value, &length))
+			return;
+
+		const std::string_view source(value, strnlen(value, sizeof(value)));
+		for (const auto& [name, id] : SourceNames) {
+			if (source == name) {
+				uniforms.push_back({ variable.handle, id });
+				return;
+			}
+		}
+	});
+
+	bound = uniforms.size();
+	if (!uniforms.empty())
+		INFO("Bound {} effect uniforms to FSR2 state", uniforms.size());
+}
+
+void EffectUniforms::Apply(effect_runtime* current)
+{
+	const auto snapshot = state.Load();
+	const auto currentFrame = frame.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	if (current != runtime || uniforms.empty())
+		return;
+
+	const float scale = snapshot.displaySize.width ? float(snapshot.renderSize.width) / float(snapshot.displaySize.width) : 1.0f;
+	const float values[][2] = {
+		{ float(snapshot.renderSize.width), float(snapshot.renderSize.height) },
+		{ float(snapshot.displaySize.width), float(snapshot.displaySize.height) },
+		{ scale, 0.0f },
+		{ snapshot.jitter.x, snapshot.jitter.y },
+		{ snapshot.bias, 0.0f },
+		{ snapshot.dispatchFrame && currentFrame - snapshot.dispatchFrame <= 2 ? 1.0f : 0.0f, 0.0f },
+	};
+	constexpr size_t counts[] = { 2, 2, 1, 2, 1, 1 };
+
+	for (const auto& uniform : uniforms) {
+		const auto index = size_t(uniform.source);
+		runtime->set_uniform_value_float({ uniform.variable }, values[index], counts[index], 0);
+	}
+}
+
+void EffectUniforms::Forget(effect_runtime* destroyed)
+{
+	if (destroyed != runtime)
+		return;
+
+	runtime = nullptr;
+	uniforms.clear();
+	bound = 0;
+}
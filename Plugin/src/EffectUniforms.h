@@ -0,0 +1,77 @@
+#pragma once
+
+#include "SeqLock.h"
+#include "ffx_types.h"
+
+namespace reshade::api
+{
+	struct effect_runtime;
+}
+
+// Exposes FSR2 state to ReShade effects through uniforms annotated with a custom source, for example
+//
+//     uniform float2 RenderSize < source = "fsr2_render_size"; >;
+//
+// Annotated uniforms are looked up once whenever effects are reloaded, and all of them are set in one pass
+// before effects render each frame.
+class EffectUniforms
+{
+public:
+	static EffectUniforms* GetSingleton()
+	{
+		static EffectUniforms singleton;
+		return &singleton;
+	}
+
+	enum class Source : uint32_t
+	{
+		RenderSize,   // float2, render resolution in pixels
+		DisplaySize,  // float2, display resolution in pixels
+		Scale,        // float, render width / display width
+		Jitter,       // float2, FSR2 jitter offset in pixels
+		Bias,         // float, mip bias currently applied
+		Active,       // float, 1 while FSR2 dispatched within the last frames
+
+		Count
+	};
+
+	void Register();
+
+	// Called whenever the bias is evaluated. Neither update blocks, Apply reads a snapshot on present.
+	void Update(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias);
+
+	// Called from the dispatch hook.
+	void UpdateJitter(FfxFloatCoords2D jitter);
+
+	size_t GetBoundUniforms() const { return bound.load(std::memory_order_relaxed); }
+
+	void Reload(reshade::api::effect_runtime* runtime);
+	void Apply(reshade::api::effect_runtime* runtime);
+	void Forget(reshade::api::effect_runtime* runtime);
+
+private:
+	struct Uniform
+	{
+		uint64_t variable;
+		Source source;
+	};
+
+	struct State
+	{
+		FfxDimensions2D renderSize{};
+		FfxDimensions2D displaySize{};
+		FfxFloatCoords2D jitter{};
+		float bias = 0.0f;
+		uint64_t dispatchFrame = 0;
+	};
+
+	EffectUniforms() = default;
+
+	SeqLock<State> state;
+	std::atomic<uint64_t> frame = 0;  // counted by Apply
+
+	// Only touched from effect runtime events
+	reshade::api::effect_runtime* runtime = nullptr;
+	std::vector<Uniform> uniforms;
+	std::atomic<size_t> bound = 0;
+};
@@ -0,0 +1,173 @@
+#include "EventLog.h"
+
+#include "Worker.h"
+
+namespace
+{
+	using Level = EventFormat::Level;
+
+	struct Definition
+	{
+		const char* name;
+		const char* format;
+		Level level;
+		int64_t intervalMilliseconds;  // one token per interval
+		int64_t burst;                 // bucket size
+	};
+
+	constexpr Definition Definitions[] = {
+		{ "bad_bias", "Upscaling Fix BAD VALUE : renderResolutionX {} displayResolutionX {} bias {}", Level::Error, 10000, 1 },
+		{ "pipeline_create_failed", "Failed to create FSR2 pipeline for pass {} ({:X})", Level::Error, 1000, 4 },
+		{ "screenshot_failed", "Failed to capture screenshot for pair {}", Level::Error, 1000, 2 },
+		{ "bias_changed", "fMipBias changed to {} (version {})", Level::Debug, 100, 16 },
+		{ "reset", "FSR2 history reset", Level::Info, 1000, 4 },
+		{ "invalid_dispatch", "Ignoring FSR2 dispatch with invalid parameters (reason {}, render size {}x{})", Level::Error, 10000, 1 },
+		{ "invalid_context", "Not pooling FSR2 context with invalid sizes (display {}x{}, max render {}x{})", Level::Error, 10000, 1 },
+	};
+
+	static_assert(std::size(Definitions) == static_cast<size_t>(EventLog::Event::Count));
+
+	int64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	template <class T>
+	void Write(std::ofstream& file, T value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void WriteString(std::ofstream& file, std::string_view string, auto length)
+	{
+		Write(file, static_cast<decltype(length)>(string.size()));
+		file.write(string.data(), string.size());
+	}
+}
+
+void EventLog::Start(std::filesystem::path newBinaryPath)
+{
+	if (started.exchange(true))
+		return;
+
+	binaryPath = std::move(newBinaryPath);
+	startTime = Now();
+	Worker::GetSingleton()->Every(DrainInterval, [this] { Drain(); });
+}
+
+void EventLog::Post(Event event, std::initializer_list<Arg> args)
+{
+	const auto now = Now();
+	if (!Admit(event, now))
+		return;
+
+	Record record{ now, event, limits[static_cast<size_t>(event)].suppressed.exchange(0, std::memory_order_relaxed), {} };
+	std::copy(args.begin(), args.end(), record.args.begin());
+	if (!records.Push(record))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool EventLog::Admit(Event event, int64_t now)
+{
+	const auto& definition = Definitions[static_cast<size_t>(event)];
+	auto& limit = limits[static_cast<size_t>(event)];
+	const auto interval = definition.intervalMilliseconds * 1000;
+	const auto capacity = interval * definition.burst;
+
+	auto fullAt = limit.fullAt.load(std::memory_order_relaxed);
+	while (true) {
+		// An idle bucket refills up to its capacity and no further
+		const auto from = std::max(fullAt, now);
+		if (from + interval - now > capacity) {
+			limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+			limit.totalSuppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		if (limit.fullAt.compare_exchange_weak(fullAt, from + interval, std::memory_order_relaxed))
+			return true;
+	}
+}
+
+void EventLog::Drain()
+{
+	const bool toBinary = binary.load(std::memory_order_relaxed);
+	if (toBinary && !binaryFile.is_open() && !OpenBinary())
+		binary = false;
+	else if (!toBinary && binaryFile.is_open())
+		binaryFile.close();
+
+	Record record;
+	bool wrote = false;
+	while (records.Pop(record)) {
+		if (binaryFile.is_open())
+			WriteBinary(record);
+		else
+			WriteText(record);
+		wrote = true;
+	}
+
+	// Flushed per batch so a crash loses at most the last few milliseconds of a long session
+	if (wrote && binaryFile.is_open())
+		binaryFile.flush();
+}
+
+void EventLog::WriteText(const Record& record)
+{
+	const auto& definition = Definitions[static_cast<size_t>(record.event)];
+
+	auto text = EventFormat::Format(definition.format, ArgTypes[static_cast<size_t>(record.event)], record.args.data());
+	if (record.suppressed)
+		text += " (" + std::to_string(record.suppressed) + " similar events suppressed)";
+
+	switch (definition.level) {
+	case Level::Error:
+		ERROR("{}", text);
+		break;
+	case Level::Info:
+		INFO("{}", text);
+		break;
+	default:
+		DEBUG("{}", text);
+		break;
+	}
+}
+
+bool EventLog::OpenBinary()
+{
+	auto& file = binaryFile;
+	file.open(binaryPath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		ERROR("Failed to open {} for the binary event log", binaryPath.string());
+		return false;
+	}
+
+	const auto unixTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	file.write(EventFormat::Magic, sizeof(EventFormat::Magic));
+	Write(file, EventFormat::Version);
+	Write(file, static_cast<int64_t>(unixTime - (Now() - startTime)));
+	Write(file, static_cast<uint16_t>(std::size(Definitions)));
+	for (size_t i = 0; i < std::size(Definitions); i++) {
+		const auto& definition = Definitions[i];
+		Write(file, definition.level);
+		WriteString(file, definition.name, uint8_t());
+		WriteString(file, ArgTypes[i], uint8_t());
+		WriteString(file, definition.format, uint16_t());
+	}
+
+	binaryBytes = static_cast<uint64_t>(file.tellp());
+	INFO("Writing binary event log to {}", binaryPath.string());
+	return true;
+}
+
+void EventLog::WriteBinary(const Record& record)
+{
+	auto& file = binaryFile;
+	const auto argCount = ArgTypes[static_cast<size_t>(record.event)].size();
+
+	Write(file, record.event);
+	Write(file, record.suppressed);
+	Write(file, record.time - startTime);
+	file.write(reinterpret_cast<const char*>(record.args.data()), argCount * sizeof(Arg));
+
+	binaryBytes.fetch_add(sizeof(uint16_t) + sizeof(uint32_t) + sizeof(int64_t) + argCount * sizeof(Arg), std::memory_order_relaxed);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "EventFormat.h"
+#include "MpscRing.h"
+
+// Logging for the render and dispatch threads. Post only checks the event's rate limit and copies a fixed
+// size record into a lock-free queue; formatting and file I/O happen in a periodic worker task. Every event
+// has its own token bucket, events over the limit are counted and reported with the next one that gets
+// through. Records go to the spdlog text log, or in binary mode to a compact file whose header holds the
+// format strings once (see EventFormat.h), decoded offline with tools/event_decode.
+class EventLog
+{
+public:
+	static EventLog* GetSingleton()
+	{
+		static EventLog singleton;
+		return &singleton;
+	}
+
+	enum class Event : uint16_t
+	{
+		BadBias,
+		PipelineCreateFailed,
+		ScreenshotFailed,
+		BiasChanged,
+		Reset,
+		InvalidDispatch,
+		InvalidContext,
+		Count
+	};
+
+	static constexpr size_t MaxArgs = 4;
+
+	// One EventFormat type per argument of each event, 'i' for integers and 'f' for floating point. Post
+	// checks its arguments against these at compile time, and the binary header carries them to the decoder.
+	static constexpr std::string_view ArgTypes[] = {
+		"fff",   // BadBias: render width, display width, bias
+		"ii",    // PipelineCreateFailed: pass, result
+		"i",     // ScreenshotFailed: pair
+		"fi",    // BiasChanged: bias, version
+		"",      // Reset
+		"iii",   // InvalidDispatch: reason, render width, render height
+		"iiii",  // InvalidContext: display width, height, max render width, height
+	};
+
+	static_assert(std::size(ArgTypes) == static_cast<size_t>(Event::Count));
+
+	using Arg = EventFormat::Arg;
+	using Args = std::array<Arg, MaxArgs>;
+
+	std::atomic<bool> binary = false;
+
+	void Start(std::filesystem::path binaryPath);
+
+	template <Event E, class... T>
+	void Post(T... args)
+	{
+		static constexpr char Types[] = { TypeOf<T>()..., '\0' };
+		static_assert(ArgTypes[static_cast<size_t>(E)] == std::string_view(Types), "arguments do not match the event's ArgTypes");
+		static_assert(sizeof...(T) <= MaxArgs);
+		Post(E, { ToArg(args)... });
+	}
+
+	uint64_t GetSuppressed(Event event) const { return limits[static_cast<size_t>(event)].totalSuppressed.load(std::memory_order_relaxed); }
+	uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+	uint64_t GetBinaryBytes() const { return binaryBytes.load(std::memory_order_relaxed); }
+
+private:
+	// bench/EventLogBench.cpp empties the token buckets and the queue to time the admitted path on its own
+	friend struct EventLogBench;
+
+	struct Record
+	{
+		int64_t time;
+		Event event;
+		uint32_t suppressed;
+		Args args;
+	};
+
+	struct Limit
+	{
+		// Token bucket kept as the time the bucket is full again, so taking a token is a single CAS
+		std::atomic<int64_t> fullAt = 0;
+		std::atomic<uint32_t> suppressed = 0;
+		std::atomic<uint64_t> totalSuppressed = 0;
+	};
+
+	EventLog() = default;
+
+	template <class T>
+	static constexpr char TypeOf()
+	{
+		if constexpr (std::is_floating_point_v<T>) {
+			return 'f';
+		} else {
+			static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "events take integer and floating point arguments only");
+			return 'i';
+		}
+	}
+
+	template <class T>
+	static Arg ToArg(T value)
+	{
+		Arg arg{};
+		if constexpr (std::is_floating_point_v<T>)
+			arg.f = value;
+		else
+			arg.i = static_cast<int64_t>(value);
+		return arg;
+	}
+
+	void Post(Event event, std::initializer_list<Arg> args);
+	bool Admit(Event event, int64_t now);
+	static constexpr auto DrainInterval = std::chrono::milliseconds(10);
+
+	void Drain();
+	void WriteText(const Record& record);
+	void WriteBinary(const Record& record);
+	bool OpenBinary();
+
+	std::array<Limit, static_cast<size_t>(Event::Count)> limits;
+	MpscRing<Record, 1024> records;
+	std::atomic<uint64_t> dropped = 0;
+	std::atomic<bool> started = false;
+
+	// Worker only
+	std::filesystem::path binaryPath;
+	std::ofstream binaryFile;
+	int64_t startTime = 0;
+	std::atomic<uint64_t> binaryBytes = 0;
+};
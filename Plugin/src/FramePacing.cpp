@@ -0,0 +1,176 @@
+#include "FramePacing.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+using namespace reshade::api;
+
+namespace
+{
+	void OnPresent(command_queue*, swapchain*, const rect*, const rect*, uint32_t, const rect*)
+	{
+		FramePacing::GetSingleton()->Record();
+	}
+}
+
+void FramePacing::Register()
+{
+	reshade::register_event<reshade::addon_event::present>(&OnPresent);
+}
+
+void FramePacing::Record()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const auto previous = std::exchange(lastPresent, now);
+
+	const float currentBias = bias.load(std::memory_order_relaxed);
+	const bool biasChanged = currentBias != lastBias;
+	lastBias = currentBias;
+	const bool wasReset = reset.exchange(false, std::memory_order_relaxed);
+
+	if (!recording.load(std::memory_order_relaxed) || !previous.time_since_epoch().count())
+		return;
+
+	const Sample sample{
+		std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(),
+		std::chrono::duration<float, std::milli>(now - previous).count(),
+		currentBias,
+		biasChanged,
+		wasReset
+	};
+
+	if (!ring.Push(sample))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+
+	if (++presents % DrainFrames == 0 && queue)
+		queue->Post([this] { Drain(); });
+}
+
+void FramePacing::StartRecording(std::filesystem::path path)
+{
+	if (recording || !queue)
+		return;
+
+	dropped = 0;
+	recording = true;
+	queue->Post([this, path = std::move(path)] { Open(path); });
+}
+
+void FramePacing::StopRecording()
+{
+	if (!recording)
+		return;
+
+	recording = false;
+	queue->Post([this] { Close(); });
+}
+
+void FramePacing::Open(const std::filesystem::path& path)
+{
+	file.open(path, std::ios::trunc);
+	if (!file) {
+		ERROR("Failed to open {} for frame pacing", path.string());
+		recording = false;
+		return;
+	}
+	file << "frame,time_ms,frame_ms,median_ms,spike,bias,bias_changed,reset,spike_near_bias_change,spike_near_reset\n";
+
+	{
+		std::lock_guard guard(lock);
+		metrics = {};
+	}
+	pending.clear();
+	window.Clear();
+	frame = 0;
+	written = 0;
+
+	INFO("Recording frame pacing to {}", path.string());
+}
+
+void FramePacing::Close()
+{
+	Drain();
+	if (!file.is_open())
+		return;
+
+	Flush(true);
+	file.close();
+
+	const auto summary = GetMetrics();
+	INFO("Frame pacing: {} frames, median {:.2f} ms, stddev {:.2f} ms, {} spikes ({} near bias changes, {} near resets), {} samples dropped",
+		summary.frames, summary.medianMilliseconds, summary.stddevMilliseconds, summary.spikes, summary.spikesNearBiasChange, summary.spikesNearReset, summary.dropped);
+}
+
+FramePacing::Metrics FramePacing::GetMetrics()
+{
+	std::lock_guard guard(lock);
+	auto result = metrics;
+	result.dropped = dropped.load(std::memory_order_relaxed);
+	return result;
+}
+
+void FramePacing::Drain()
+{
+	Sample sample;
+	while (ring.Pop(sample)) {
+		if (file.is_open())
+			Process(sample);
+	}
+	if (file.is_open())
+		file.flush();
+}
+
+void FramePacing::Process(const Sample& sample)
+{
+	window.Add(sample.frameMilliseconds);
+	frame++;
+	const float median = window.Median();
+
+	// Spikes only count once the window is full, otherwise the first frames after a hitch dominate the median
+	const bool spike = window.Full() && sample.frameMilliseconds > median * SpikeFactor;
+
+	{
+		std::lock_guard guard(lock);
+		metrics.frames = frame;
+		metrics.medianMilliseconds = median;
+		metrics.stddevMilliseconds = window.Stddev();
+	}
+
+	pending.push_back({ sample, frame, median, spike });
+	Flush(false);
+}
+
+void FramePacing::Flush(bool final)
+{
+	// A row is written once CorrelationFrames frames after it are known, and the same number of frames
+	// before it are kept, so a spike can be correlated with events on both sides
+	while (written < pending.size() && (final || pending.size() - written > CorrelationFrames)) {
+		const auto& row = pending[written];
+
+		bool nearBiasChange = false, nearReset = false;
+		if (row.spike) {
+			const size_t first = written >= CorrelationFrames ? written - CorrelationFrames : 0;
+			const size_t last = std::min(written + CorrelationFrames, pending.size() - 1);
+			for (size_t i = first; i <= last; i++) {
+				nearBiasChange |= pending[i].sample.biasChanged;
+				nearReset |= pending[i].sample.reset;
+			}
+
+			std::lock_guard guard(lock);
+			metrics.spikes++;
+			metrics.spikesNearBiasChange += nearBiasChange;
+			metrics.spikesNearReset += nearReset;
+		}
+
+		file << std::format("{},{:.3f},{:.3f},{:.3f},{},{},{},{},{},{}\n",
+			row.frame, double(row.sample.timestamp) / 1e6, row.sample.frameMilliseconds, row.median,
+			int(row.spike), row.sample.bias, int(row.sample.biasChanged), int(row.sample.reset), int(nearBiasChange), int(nearReset));
+
+		written++;
+		while (written > CorrelationFrames) {
+			pending.pop_front();
+			written--;
+		}
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "SpscRing.h"
+#include "Statistics.h"
+#include "Worker.h"
+
+// Present-to-present frame timing, as opposed to the game's own frameTimeDelta. The present callback only
+// timestamps the frame and pushes a sample into a lock-free ring. While recording, worker jobs posted every
+// few frames compute a rolling median, the frame time variance and spikes above the median. They also
+// correlate every spike with bias transitions and FSR2 history resets within a few frames, and write
+// everything to CSV. Starting and stopping go through the same queue, so they are ordered with the drains.
+class FramePacing
+{
+public:
+	static FramePacing* GetSingleton()
+	{
+		static FramePacing singleton;
+		return &singleton;
+	}
+
+	static constexpr size_t RingSize = 1024;
+	static constexpr size_t MedianWindow = 31;
+	static constexpr float SpikeFactor = 1.5f;
+	static constexpr size_t CorrelationFrames = 2;
+	static constexpr uint64_t DrainFrames = 16;
+
+	struct Metrics
+	{
+		uint64_t frames = 0;
+		uint64_t dropped = 0;
+		float medianMilliseconds = 0.0f;
+		float stddevMilliseconds = 0.0f;
+		uint32_t spikes = 0;
+		uint32_t spikesNearBiasChange = 0;
+		uint32_t spikesNearReset = 0;
+	};
+
+	void Register();
+
+	// Called from the present event. Recording is started and stopped on the same thread.
+	void Record();
+
+	// Called from the dispatch hook.
+	void MarkReset() { reset.store(true, std::memory_order_relaxed); }
+	void MarkBias(float newBias) { bias.store(newBias, std::memory_order_relaxed); }
+
+	void StartRecording(std::filesystem::path path);
+	void StopRecording();
+	bool IsRecording() const { return recording.load(std::memory_order_relaxed); }
+
+	Metrics GetMetrics();
+
+private:
+	struct Sample
+	{
+		int64_t timestamp;  // nanoseconds
+		float frameMilliseconds;
+		float bias;
+		bool biasChanged;
+		bool reset;
+	};
+
+	struct Row
+	{
+		Sample sample;
+		uint64_t frame;
+		float median;
+		bool spike;
+	};
+
+	FramePacing() = default;
+
+	void Open(const std::filesystem::path& path);
+	void Close();
+	void Drain();
+	void Process(const Sample& sample);
+	void Flush(bool final);
+
+	// Present thread
+	std::chrono::steady_clock::time_point lastPresent;
+	float lastBias = 0.0f;
+	uint64_t presents = 0;
+	Worker::Queue* queue = Worker::GetSingleton()->CreateQueue("frame pacing");
+
+	std::atomic<bool> reset = false;
+	std::atomic<float> bias = 0.0f;
+	std::atomic<bool> recording = false;
+	std::atomic<uint64_t> dropped = 0;
+	SpscRing<Sample, RingSize> ring;
+
+	// Worker only
+	std::ofstream file;
+	std::deque<Row> pending;
+	RollingWindow<MedianWindow> window;
+	uint64_t frame = 0;
+	size_t written = 0;  // rows of the pending queue already written to the file
+
+	std::mutex lock;
+	Metrics metrics;
+};
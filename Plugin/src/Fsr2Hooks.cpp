@@ -0,0 +1,128 @@
+#include "Fsr2Hooks.h"
+
+#include "BiasMath.h"
+#include "BiasPublisher.h"
+#include "Config.h"
+#include "ContextPool.h"
+#include "EventLog.h"
+#include "FfxUtil.h"
+#include "HookProfiler.h"
+#include "Metrics.h"
+
+namespace
+{
+	Metrics::Counter dispatches{ "fsr2.dispatches" };
+	Metrics::Counter invalidDispatches{ "fsr2.invalid_dispatches" };
+	Metrics::Counter resets{ "fsr2.resets" };
+	Metrics::Counter contextCreations{ "fsr2.context_creations" };
+	Metrics::Counter invalidContexts{ "fsr2.invalid_contexts" };
+	Metrics::Gauge renderWidth{ "fsr2.render_width", "px" };
+	Metrics::Gauge displayWidth{ "fsr2.display_width", "px" };
+}
+
+void Fsr2Hooks::SetDispatchLayout(FfxLayout::Version version)
+{
+	preDispatch = version == FfxLayout::Version::Fsr20 ? &Fsr2Hooks::PreDispatch<FfxLayout::Version::Fsr20> : &Fsr2Hooks::PreDispatch<FfxLayout::Version::Fsr22>;
+}
+
+FfxErrorCode Fsr2Hooks::ContextCreate_hook(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription)
+{
+	auto hooks = GetSingleton();
+
+	// Leave a context we can't make sense of entirely to the game
+	if (!FfxUtil::IsValidContext(*contextDescription)) {
+		invalidContexts.Add();
+		EventLog::GetSingleton()->Post<EventLog::Event::InvalidContext>(contextDescription->displaySize.width, contextDescription->displaySize.height, contextDescription->maxRenderSize.width, contextDescription->maxRenderSize.height);
+		return hooks->createOriginal(context, contextDescription);
+	}
+
+	contextCreations.Add();
+	hooks->displaySize = contextDescription->displaySize;
+	displayWidth.Set(hooks->displaySize.width);
+	INFO("Initial displaySize {} {}", hooks->displaySize.width, hooks->displaySize.height);
+
+	if (hooks->listeners.contextCreated)
+		hooks->listeners.contextCreated();
+
+	return ContextPool::GetSingleton()->Create(context, contextDescription, hooks->createOriginal);
+}
+
+FfxErrorCode Fsr2Hooks::ContextDispatch_hook(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams)
+{
+	auto hooks = GetSingleton();
+	auto profiler = HookProfiler::GetSingleton();
+	if (!profiler->enabled.load(std::memory_order_relaxed)) {
+		(hooks->*hooks->preDispatch)(context, dispatchParams);
+		return hooks->Dispatch(context, dispatchParams);
+	}
+
+	return profiler->Measure(
+		context, hooks->forceDisable.load(std::memory_order_relaxed),
+		[&] { (hooks->*hooks->preDispatch)(context, dispatchParams); },
+		[&] { return hooks->Dispatch(context, dispatchParams); });
+}
+
+template <FfxLayout::Version V>
+void Fsr2Hooks::PreDispatch(FfxFsr2Context* context, void* dispatchParams)
+{
+	using Dispatch = FfxLayout::Dispatch<V>;
+	auto fields = Dispatch::Read(dispatchParams);
+
+	// An invalid dispatch is still passed on, the game owns it, but none of its values are used
+	const auto error = FfxUtil::ValidateDispatch(fields, displaySize);
+	if (error == FfxUtil::DispatchError::None) {
+		dispatches.Add();
+		renderWidth.Set(fields.renderSize.width);
+		lastDispatchPresent.store(presentCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		AdjustBias(fields.renderSize, displaySize, true);
+		if (listeners.dispatched)
+			listeners.dispatched(fields);
+	} else {
+		invalidDispatches.Add();
+		EventLog::GetSingleton()->Post<EventLog::Event::InvalidDispatch>(static_cast<uint32_t>(error), fields.renderSize.width, fields.renderSize.height);
+	}
+
+	if (ContextPool::GetSingleton()->ConsumeReset(context)) {
+		Dispatch::SetReset(dispatchParams);
+		fields.reset = true;
+	}
+
+	if (fields.reset) {
+		resets.Add();
+		if (listeners.reset)
+			listeners.reset();
+		EventLog::GetSingleton()->Post<EventLog::Event::Reset>();
+	}
+}
+
+FfxErrorCode Fsr2Hooks::Dispatch(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams)
+{
+	if (listeners.beginDispatch)
+		listeners.beginDispatch();
+	const auto result = dispatchOriginal(context, dispatchParams);
+	if (listeners.endDispatch)
+		listeners.endDispatch();
+	return result;
+}
+
+void Fsr2Hooks::AdjustBias(FfxDimensions2D renderSize, FfxDimensions2D newDisplaySize, bool fromDispatch)
+{
+	const auto settings = Config::GetSingleton()->Get();
+	const auto profile = settings->profiles.Find(renderSize.width, renderSize.height, newDisplaySize.width, newDisplaySize.height);
+	const auto result = BiasMath::Compute(renderSize, newDisplaySize, settings->bias, (profile ? profile->biasOffset : 0.0f) + BiasOffsets[biasOffsetIndex.load(std::memory_order_relaxed)]);
+
+	if (result.outOfRange || !result.valid)
+		EventLog::GetSingleton()->Post<EventLog::Event::BadBias>(float(renderSize.width), float(newDisplaySize.width), result.ratioBias);
+	if (!result.valid)
+		return;
+
+	const float appliedBias = forceDisable.load(std::memory_order_relaxed) || !settings->enabled ? 0.0f : result.bias;
+	const float settingBias = listeners.biasApplied ? listeners.biasApplied(renderSize, newDisplaySize, appliedBias, fromDispatch) : appliedBias;
+	BiasPublisher::GetSingleton()->Publish(settingBias);
+}
+
+bool Fsr2Hooks::CountPresent()
+{
+	const auto present = presentCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	return present - lastDispatchPresent.load(std::memory_order_relaxed) > 2;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "FfxLayout.h"
+#include "ffx_fsr2.h"
+
+// The FSR2 context create and dispatch hooks, without their installation. Everything they do that needs
+// neither Windows nor ReShade lives here, so the same path runs against the FSR2 mock in tests and
+// benchmarks: validation, the bias formula and its publication, context pooling, events and metrics.
+// main.cpp finds the call sites, installs the hooks and plugs the ReShade side in through Listeners,
+// which run on the thread calling the hook.
+class Fsr2Hooks
+{
+public:
+	static Fsr2Hooks* GetSingleton()
+	{
+		static Fsr2Hooks singleton;
+		return &singleton;
+	}
+
+	using CreateFunc = FfxErrorCode (*)(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription);
+	using DispatchFunc = FfxErrorCode (*)(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams);
+
+	// All optional
+	struct Listeners
+	{
+		void (*contextCreated)() = nullptr;
+
+		// Returns the bias for the game setting, which stays neutral while the bias is applied elsewhere.
+		float (*biasApplied)(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias, bool fromDispatch) = nullptr;
+
+		// After the bias of a valid dispatch was applied
+		void (*dispatched)(const FfxLayout::DispatchFields& fields) = nullptr;
+		void (*reset)() = nullptr;
+
+		// Around the original dispatch
+		void (*beginDispatch)() = nullptr;
+		void (*endDispatch)() = nullptr;
+	};
+
+	// Added to the computed bias, cycled with a hot key to compare against the plain formula
+	static constexpr float BiasOffsets[] = { 0.0f, -0.25f, -0.5f, 0.25f };
+
+	// Written by the overlay and hot keys on the present thread only, read by the hooks on the render thread
+	std::atomic<bool> forceDisable = false;
+	std::atomic<size_t> biasOffsetIndex = 0;
+
+	void SetListeners(const Listeners& newListeners) { listeners = newListeners; }
+	void SetCreateOriginal(CreateFunc original) { createOriginal = original; }
+	void SetDispatchOriginal(DispatchFunc original) { dispatchOriginal = original; }
+
+	// The game's SDK version decides the dispatch description layout, set before the dispatch hook is written
+	void SetDispatchLayout(FfxLayout::Version version);
+
+	static FfxErrorCode ContextCreate_hook(FfxFsr2Context* context, FfxFsr2ContextDescription* contextDescription);
+	static FfxErrorCode ContextDispatch_hook(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams);
+
+	// Computes and applies the bias of a frame. Resolution detection calls this for frames without FSR2.
+	void AdjustBias(FfxDimensions2D renderSize, FfxDimensions2D displaySize, bool fromDispatch);
+
+	// Counts a present. Returns false while FSR2 dispatched within the last two presents, in which case
+	// FSR2 knows the render size better than resolution detection.
+	bool CountPresent();
+
+	FfxDimensions2D GetDisplaySize() const { return displaySize; }
+
+private:
+	Fsr2Hooks() = default;
+
+	// Instantiated per description layout, the one matching the game is picked with the original
+	template <FfxLayout::Version V>
+	void PreDispatch(FfxFsr2Context* context, void* dispatchParams);
+
+	FfxErrorCode Dispatch(FfxFsr2Context* context, FfxFsr2DispatchDescription* dispatchParams);
+
+	Listeners listeners;
+	CreateFunc createOriginal = nullptr;
+	DispatchFunc dispatchOriginal = nullptr;
+	void (Fsr2Hooks::*preDispatch)(FfxFsr2Context* context, void* dispatchParams) = nullptr;
+
+	FfxDimensions2D displaySize{};
+	std::atomic<uint64_t> presentCount = 0;
+	std::atomic<uint64_t> lastDispatchPresent = 0;
+};
@@ -0,0 +1,133 @@
+#include "GpuProfiler.h"
+
+#include "Overlay.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+#include <d3d12.h>
+
+using namespace reshade::api;
+
+namespace
+{
+	struct DispatchState
+	{
+		bool active = false;
+		command_list* cmdList = nullptr;
+		int32_t query = -1;
+	};
+
+	thread_local DispatchState _dispatchState;
+}
+
+void GpuProfiler::Register()
+{
+	reshade::register_event<reshade::addon_event::dispatch>(&OnDispatch);
+	reshade::register_event<reshade::addon_event::present>(&OnPresent);
+	reshade::register_event<reshade::addon_event::destroy_device>(&OnDestroyDevice);
+}
+
+bool GpuProfiler::OnDispatch(command_list* cmdList, uint32_t, uint32_t, uint32_t)
+{
+	if (_dispatchState.active && !_dispatchState.cmdList)
+		GetSingleton()->StartMeasurement(cmdList);
+	return false;
+}
+
+void GpuProfiler::OnPresent(command_queue* queue, swapchain*, const rect*, const rect*, uint32_t, const rect*)
+{
+	GetSingleton()->Resolve(queue);
+}
+
+void GpuProfiler::OnDestroyDevice(device* destroyed)
+{
+	GetSingleton()->ReleaseDevice(destroyed);
+}
+
+void GpuProfiler::BeginDispatch()
+{
+	_dispatchState = { true, nullptr, -1 };
+}
+
+void GpuProfiler::StartMeasurement(command_list* cmdList)
+{
+	_dispatchState.cmdList = cmdList;
+
+	std::lock_guard guard(lock);
+
+	auto cmdListDevice = cmdList->get_device();
+	if (queryDevice != cmdListDevice) {
+		if (queryDevice && queryPool)
+			queryDevice->destroy_query_pool({ queryPool });
+		queryDevice = cmdListDevice;
+		queryPool = 0;
+		ring.Clear();
+
+		query_pool pool{};
+		if (!queryDevice->create_query_pool(query_type::timestamp, TimestampRing::QueryCount, &pool)) {
+			ERROR("Failed to create timestamp query pool, FSR2 GPU time will not be measured");
+			return;
+		}
+		queryPool = pool.handle;
+	}
+
+	if (!queryPool)
+		return;
+
+	_dispatchState.query = ring.Begin();
+	if (_dispatchState.query >= 0)
+		cmdList->end_query({ queryPool }, query_type::timestamp, _dispatchState.query);
+}
+
+void GpuProfiler::EndDispatch()
+{
+	auto state = std::exchange(_dispatchState, {});
+	if (!state.cmdList || state.query < 0)
+		return;
+
+	std::lock_guard guard(lock);
+	if (!queryPool || state.cmdList->get_device() != queryDevice) {
+		ring.Abandon(state.query);
+		return;
+	}
+
+	state.cmdList->end_query({ queryPool }, query_type::timestamp, state.query + 1);
+	ring.End(state.query);
+}
+
+void GpuProfiler::Resolve(command_queue* queue)
+{
+	std::lock_guard guard(lock);
+	ring.Present();
+	if (!queryPool || queue->get_device() != queryDevice)
+		return;
+
+	if (!frequency && queryDevice->get_api() == device_api::d3d12)
+		reinterpret_cast<ID3D12CommandQueue*>(queue->get_native())->GetTimestampFrequency(&frequency);
+
+	ring.Resolve(
+		frequency,
+		[&](uint32_t first, uint32_t count, uint64_t* ticks) {
+			return queryDevice->get_query_pool_results({ queryPool }, first, count, ticks, sizeof(uint64_t));
+		},
+		[&](double milliseconds) {
+			lastMilliseconds.store(float(milliseconds), std::memory_order_relaxed);
+			Overlay::GetSingleton()->RecordGpuTime(float(milliseconds));
+		});
+}
+
+void GpuProfiler::ReleaseDevice(device* destroyed)
+{
+	std::lock_guard guard(lock);
+	if (destroyed != queryDevice)
+		return;
+
+	if (queryPool)
+		queryDevice->destroy_query_pool({ queryPool });
+	queryDevice = nullptr;
+	queryPool = 0;
+	frequency = 0;
+	ring.Clear();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "TimestampRing.h"
+
+namespace reshade::api
+{
+	struct command_list;
+	struct command_queue;
+	struct device;
+	struct rect;
+	struct swapchain;
+}
+
+// Measures the GPU time of the FSR2 dispatch with timestamp queries written to the game's own command list.
+// The ReShade command list is not known to the FSR2 hook, so it is picked up from the first compute dispatch
+// ReShade reports while the hook is running, which is where the begin timestamp goes. The end timestamp is
+// written after the original ffxFsr2ContextDispatch returns. Results are read back through a TimestampRing.
+class GpuProfiler
+{
+public:
+	static GpuProfiler* GetSingleton()
+	{
+		static GpuProfiler singleton;
+		return &singleton;
+	}
+
+	void Register();
+
+	// Bracket the original ffxFsr2ContextDispatch, on the thread recording the dispatch.
+	void BeginDispatch();
+	void EndDispatch();
+
+	float GetLastMilliseconds() const { return lastMilliseconds.load(std::memory_order_relaxed); }
+
+private:
+	GpuProfiler() = default;
+
+	static bool OnDispatch(reshade::api::command_list* cmdList, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+	static void OnPresent(reshade::api::command_queue* queue, reshade::api::swapchain* swapchain, const reshade::api::rect* sourceRect, const reshade::api::rect* destRect, uint32_t dirtyRectCount, const reshade::api::rect* dirtyRects);
+	static void OnDestroyDevice(reshade::api::device* destroyed);
+
+	void StartMeasurement(reshade::api::command_list* cmdList);
+	void Resolve(reshade::api::command_queue* queue);
+	void ReleaseDevice(reshade::api::device* destroyed);
+
+	std::mutex lock;
+	reshade::api::device* queryDevice = nullptr;
+	uint64_t queryPool = 0;
+	uint64_t frequency = 0;
+	TimestampRing ring;
+	std::atomic<float> lastMilliseconds = 0.0f;
+};
@@ -0,0 +1,118 @@
+#include "HookProfiler.h"
+
+#include "Metrics.h"
+#include "Worker.h"
+
+#include <nlohmann/json.hpp>
+
+namespace
+{
+	Metrics::Histogram hookTime{ "hook.dispatch_time", "ns", { 250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000 } };
+}
+
+void HookProfiler::Start()
+{
+	Worker::GetSingleton()->Every(DrainInterval, [this] { Drain(); });
+}
+
+void HookProfiler::Record(const void* context, bool forceDisabled, std::chrono::steady_clock::duration hook, std::chrono::steady_clock::duration original)
+{
+	const Sample sample{
+		context,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(hook).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(original).count(),
+		forceDisabled
+	};
+
+	hookTime.Record(double(sample.hook));
+	if (!samples.Push(sample))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HookProfiler::Drain()
+{
+	std::lock_guard guard(lock);
+	Fold();
+}
+
+void HookProfiler::Fold()
+{
+	Sample sample;
+	while (samples.Pop(sample)) {
+		auto stats = std::ranges::find_if(contexts, [&](const ContextStats& stats) { return !stats.context || stats.context == sample.context; });
+		if (stats == contexts.end()) {
+			overflow++;
+			continue;
+		}
+
+		stats->context = sample.context;
+		stats->hook[sample.forceDisabled].Add(sample.hook);
+		stats->original[sample.forceDisabled].Add(sample.original);
+	}
+}
+
+void HookProfiler::Reset()
+{
+	std::lock_guard guard(lock);
+	Fold();
+	contexts = {};
+	overflow = 0;
+	dropped.store(0, std::memory_order_relaxed);
+}
+
+static nlohmann::json ToJson(const RunningStats& stats)
+{
+	if (!stats.count)
+		return { { "count", 0 } };
+
+	return {
+		{ "count", stats.count },
+		{ "mean_ns", stats.Mean() },
+		{ "stddev_ns", stats.Stddev() },
+		{ "min_ns", stats.min },
+		{ "max_ns", stats.max },
+	};
+}
+
+bool HookProfiler::Export(const std::filesystem::path& path)
+{
+	nlohmann::json json;
+	{
+		std::lock_guard guard(lock);
+		Fold();
+
+		json["version"] = Plugin::Version;
+		json["overflow"] = overflow;
+		json["dropped"] = GetDropped();
+		auto& results = json["contexts"] = nlohmann::json::array();
+		for (auto& stats : contexts) {
+			if (!stats.context)
+				continue;
+
+			char context[2 * sizeof(uintptr_t) + 1];
+			std::snprintf(context, sizeof(context), "%" PRIXPTR, reinterpret_cast<uintptr_t>(stats.context));
+
+			for (int forceDisabled = 0; forceDisabled < 2; forceDisabled++) {
+				if (!stats.hook[forceDisabled].count)
+					continue;
+
+				results.push_back({
+					{ "context", context },
+					{ "force_disabled", forceDisabled != 0 },
+					{ "hook", ToJson(stats.hook[forceDisabled]) },
+					{ "original", ToJson(stats.original[forceDisabled]) },
+				});
+			}
+		}
+	}
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file) {
+		ERROR("Failed to write hook timings to {}", path.string());
+		return false;
+	}
+
+	file << json.dump(1, '\t');
+	INFO("Wrote hook timings to {}", path.string());
+	return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "MpscRing.h"
+#include "Statistics.h"
+
+// Measures what the dispatch hook adds on top of the original ffxFsr2ContextDispatch, per context and
+// split by whether the fix is force-disabled. Disabled by default, in which case the hook only pays for
+// a single flag check. Enabled, the dispatching thread only pushes its sample into a lock-free ring; the
+// worker folds samples into the statistics, so a dispatch never waits on the overlay or an export.
+// Samples arriving while the ring is full are dropped and counted. Results can be exported as JSON to
+// track them across builds.
+class HookProfiler
+{
+public:
+	static HookProfiler* GetSingleton()
+	{
+		static HookProfiler singleton;
+		return &singleton;
+	}
+
+	std::atomic<bool> enabled = false;
+
+	// Folds samples on the worker from now on.
+	void Start();
+
+	template <class Hook, class Original>
+	auto Measure(const void* context, bool forceDisabled, Hook&& hook, Original&& original)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		hook();
+		const auto hooked = std::chrono::steady_clock::now();
+		auto result = original();
+		const auto end = std::chrono::steady_clock::now();
+
+		Record(context, forceDisabled, hooked - start, end - hooked);
+		return result;
+	}
+
+	// Folds the queued samples into the statistics. Export and Reset do so themselves.
+	void Drain();
+
+	void Reset();
+	bool Export(const std::filesystem::path& path);
+
+	uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+	struct Sample
+	{
+		const void* context;
+		int64_t hook;      // nanoseconds
+		int64_t original;  // nanoseconds
+		bool forceDisabled;
+	};
+
+	struct ContextStats
+	{
+		const void* context = nullptr;
+		RunningStats hook[2];      // nanoseconds, indexed by forceDisabled
+		RunningStats original[2];  // nanoseconds, indexed by forceDisabled
+	};
+
+	static constexpr size_t MaxContexts = 4;
+	static constexpr size_t Capacity = 1024;
+	static constexpr auto DrainInterval = std::chrono::milliseconds(100);
+
+	HookProfiler() = default;
+
+	void Record(const void* context, bool forceDisabled, std::chrono::steady_clock::duration hook, std::chrono::steady_clock::duration original);
+
+	// With lock held
+	void Fold();
+
+	MpscRing<Sample, Capacity> samples;
+	std::atomic<uint64_t> dropped = 0;
+
+	// Taken by consumers only: it makes whoever drains the ring's single consumer and guards the statistics
+	std::mutex lock;
+	std::array<ContextStats, MaxContexts> contexts;
+	uint64_t overflow = 0;
+};
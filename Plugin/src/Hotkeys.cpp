@@ -0,0 +1,75 @@
+#include "Hotkeys.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+namespace
+{
+	struct DefaultBinding
+	{
+		const char* name;
+		uint8_t key;
+	};
+
+	// F9, F10 and F11
+	constexpr DefaultBinding Defaults[] = {
+		{ "KeyToggleFix", 0x78 },
+		{ "KeyCycleBiasOffset", 0x79 },
+		{ "KeyToggleCapture", 0x7A },
+	};
+
+	static_assert(std::size(Defaults) == size_t(Hotkeys::Action::Count));
+
+	constexpr uint32_t VK_SHIFT_KEY = 0x10;
+	constexpr uint32_t VK_CONTROL_KEY = 0x11;
+	constexpr uint32_t VK_ALT_KEY = 0x12;
+}
+
+void Hotkeys::Load(reshade::api::effect_runtime* runtime)
+{
+	for (size_t i = 0; i < bindings.size(); i++) {
+		auto& binding = bindings[i];
+		binding = { Defaults[i].key };
+
+		char value[32];
+		size_t length = sizeof(value) - 1;
+		if (!reshade::config_get_value(runtime, "UpscalingFix", Defaults[i].name, value, &length)) {
+			reshade::config_set_value(runtime, "UpscalingFix", Defaults[i].name, std::format("{},0,0,0", binding.key).c_str());
+			continue;
+		}
+		value[std::min(length, sizeof(value) - 1)] = '\0';
+
+		unsigned key = 0, ctrl = 0, shift = 0, alt = 0;
+		if (sscanf_s(value, "%u,%u,%u,%u", &key, &ctrl, &shift, &alt) < 1 || key > 0xFF) {
+			ERROR("Invalid hot key {} = {}, using the default", Defaults[i].name, value);
+			continue;
+		}
+
+		binding = { uint8_t(key), ctrl != 0, shift != 0, alt != 0 };
+	}
+
+	loaded = true;
+}
+
+uint32_t Hotkeys::Poll(reshade::api::effect_runtime* runtime)
+{
+	if (!loaded)
+		Load(runtime);
+
+	uint32_t triggered = 0;
+	for (size_t i = 0; i < bindings.size(); i++) {
+		const auto& binding = bindings[i];
+		if (!binding.key || !runtime->is_key_pressed(binding.key))
+			continue;
+
+		if (runtime->is_key_down(VK_CONTROL_KEY) != binding.ctrl ||
+			runtime->is_key_down(VK_SHIFT_KEY) != binding.shift ||
+			runtime->is_key_down(VK_ALT_KEY) != binding.alt)
+			continue;
+
+		triggered |= 1u << i;
+	}
+
+	return triggered;
+}
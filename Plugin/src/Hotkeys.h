@@ -0,0 +1,47 @@
+#pragma once
+
+namespace reshade::api
+{
+	struct effect_runtime;
+}
+
+// Hot keys for A/B testing without opening the overlay. Bindings are read once from the [UpscalingFix]
+// section of ReShade.ini, in ReShade's own "keycode,ctrl,shift,alt" format, into a small table that is
+// polled once per frame.
+class Hotkeys
+{
+public:
+	static Hotkeys* GetSingleton()
+	{
+		static Hotkeys singleton;
+		return &singleton;
+	}
+
+	enum class Action : uint8_t
+	{
+		ToggleFix,
+		CycleBiasOffset,
+		ToggleCapture,
+
+		Count
+	};
+
+	// Returns a mask of (1 << Action) for every action triggered this frame.
+	uint32_t Poll(reshade::api::effect_runtime* runtime);
+
+private:
+	struct Binding
+	{
+		uint8_t key = 0;
+		bool ctrl = false;
+		bool shift = false;
+		bool alt = false;
+	};
+
+	Hotkeys() = default;
+
+	void Load(reshade::api::effect_runtime* runtime);
+
+	std::array<Binding, size_t(Action::Count)> bindings{};
+	bool loaded = false;
+};
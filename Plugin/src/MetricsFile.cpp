@@ -0,0 +1,64 @@
+#include "MetricsFile.h"
+
+#include "Metrics.h"
+#include "Worker.h"
+
+#include <nlohmann/json.hpp>
+
+void MetricsFile::Start(std::filesystem::path newPath)
+{
+	path = std::move(newPath);
+	Worker::GetSingleton()->Every(std::chrono::duration_cast<std::chrono::milliseconds>(WriteInterval), [this] { Write(); });
+}
+
+void MetricsFile::Write()
+{
+	if (!enabled.load(std::memory_order_relaxed))
+		return;
+
+	nlohmann::json json = nlohmann::json::object();
+	Metrics::ForEach([&](const Metrics::Metric& metric) {
+		auto& entry = json[metric.GetName()];
+		entry["unit"] = metric.GetUnit();
+
+		switch (metric.GetKind()) {
+		case Metrics::Kind::Counter:
+			entry["value"] = static_cast<const Metrics::Counter&>(metric).Get();
+			break;
+		case Metrics::Kind::Gauge:
+			entry["value"] = static_cast<const Metrics::Gauge&>(metric).Get();
+			break;
+		case Metrics::Kind::Histogram:
+			{
+				const auto& histogram = static_cast<const Metrics::Histogram&>(metric);
+				const auto snapshot = histogram.Get();
+				entry["count"] = snapshot.count;
+				entry["mean"] = snapshot.Mean();
+
+				auto& buckets = entry["buckets"] = nlohmann::json::array();
+				for (size_t i = 0; i < histogram.GetBuckets(); i++) {
+					const bool last = i + 1 == histogram.GetBuckets();
+					buckets.push_back({ { "le", last ? nlohmann::json("inf") : nlohmann::json(histogram.GetBound(i)) }, { "count", snapshot.counts[i] } });
+				}
+				break;
+			}
+		}
+	});
+
+	// Write next to the file and rename, so a reader never sees half a snapshot
+	auto temporaryPath = path;
+	temporaryPath += L".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::trunc);
+		file << json.dump(1, '\t');
+		if (!file) {
+			ERROR("Failed to write {}", temporaryPath.string());
+			return;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error)
+		ERROR("Failed to replace {}: {}", path.string(), error.message());
+}
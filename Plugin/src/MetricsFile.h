@@ -0,0 +1,27 @@
+#pragma once
+
+// Writes a snapshot of every metric to a JSON file from a periodic worker task, so the numbers can be read
+// or scraped without the overlay. The file is replaced as a whole each time. Only runs while enabled.
+class MetricsFile
+{
+public:
+	static MetricsFile* GetSingleton()
+	{
+		static MetricsFile singleton;
+		return &singleton;
+	}
+
+	static constexpr auto WriteInterval = std::chrono::seconds(10);
+
+	std::atomic<bool> enabled = false;
+
+	void Start(std::filesystem::path path);
+
+private:
+	MetricsFile() = default;
+
+	void Write();
+
+	// Worker only after Start
+	std::filesystem::path path;
+};
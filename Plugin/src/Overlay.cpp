@@ -0,0 +1,226 @@
+#include "Overlay.h"
+
+#include "ABCapture.h"
+#include "BiasPublisher.h"
+#include "Config.h"
+#include "ContextPool.h"
+#include "EffectUniforms.h"
+#include "EventLog.h"
+#include "FramePacing.h"
+#include "HookProfiler.h"
+#include "Metrics.h"
+#include "PassClassifier.h"
+#include "PipelineCache.h"
+#include "SamplerBias.h"
+#include "SamplerCache.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+namespace
+{
+	Metrics::Histogram frameTime{ "frame.time", "ms", { 8.3, 11.1, 16.7, 20, 25, 33.3, 50, 100 } };
+	Metrics::Histogram gpuTime{ "fsr2.gpu_time", "ms", { 0.25, 0.5, 1, 1.5, 2, 3, 5, 10 } };
+}
+
+void Overlay::RecordPresent()
+{
+	const auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard guard(lock);
+	if (lastPresent.time_since_epoch().count()) {
+		const auto milliseconds = std::chrono::duration<float, std::milli>(now - lastPresent).count();
+		frameTimes.Push(milliseconds);
+		frameTime.Record(milliseconds);
+	}
+	lastPresent = now;
+}
+
+void Overlay::RecordBias(FfxDimensions2D newRenderSize, FfxDimensions2D newDisplaySize, float bias, bool fromDispatch)
+{
+	std::lock_guard guard(lock);
+	renderSize = newRenderSize;
+	displaySize = newDisplaySize;
+	detected = !fromDispatch;
+	biases.Push(bias);
+	if (fromDispatch)
+		dispatches++;
+}
+
+void Overlay::RecordGpuTime(float milliseconds)
+{
+	gpuTime.Record(milliseconds);
+
+	std::lock_guard guard(lock);
+	gpuTimes.Push(milliseconds);
+}
+
+void Overlay::UpdateDispatchRate()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const auto elapsed = std::chrono::duration<float>(now - rateStart).count();
+	if (elapsed < 0.5f)
+		return;
+
+	const uint64_t total = dispatches;
+	if (rateStart.time_since_epoch().count())
+		dispatchRate = float(total - rateDispatches) / elapsed;
+	rateDispatches = total;
+	rateStart = now;
+}
+
+void Overlay::Draw(reshade::api::effect_runtime*, bool& forceDisable)
+{
+	FfxDimensions2D render, display;
+	bool renderDetected;
+	History<HistorySize> frameTimesCopy, biasesCopy, gpuTimesCopy;
+	{
+		std::lock_guard guard(lock);
+		render = renderSize;
+		display = displaySize;
+		renderDetected = detected;
+		frameTimesCopy = frameTimes;
+		biasesCopy = biases;
+		gpuTimesCopy = gpuTimes;
+		UpdateDispatchRate();
+	}
+
+	auto publisher = BiasPublisher::GetSingleton();
+	ImGui::TextUnformatted(Format("Current fMipBias {:.3f} (version {})", publisher->GetBias(), publisher->GetVersion()), nullptr);
+
+	if (display.width && display.height) {
+		const float scale = 100.0f * float(render.width) / float(display.width);
+		ImGui::TextUnformatted(Format("Render {}x{}, display {}x{} ({:.1f}%, {})", render.width, render.height, display.width, display.height, scale, renderDetected ? "detected" : "FSR2"), nullptr);
+		const auto settings = Config::GetSingleton()->Get();
+		if (auto profile = settings->profiles.Find(render.width, render.height, display.width, display.height))
+			ImGui::TextUnformatted(Format("Profile {} (bias offset {:+.2f})", profile->name, profile->biasOffset), nullptr);
+	} else {
+		ImGui::TextUnformatted("No render resolution known yet", nullptr);
+	}
+	ImGui::TextUnformatted(Format("FSR2 dispatches {:.1f}/s", dispatchRate), nullptr);
+
+	auto plot = [&](const char* label, const History<HistorySize>& history, const char* unit, float scaleMin, float scaleMax) {
+		auto result = std::format_to_n(plotText, std::size(plotText) - 1, "{:.3f} {}", history.Latest(), unit);
+		*result.out = '\0';
+		ImGui::PlotLines(label, history.values.data(), int(HistorySize), int(history.next), plotText, scaleMin, scaleMax, ImVec2(0, 60), sizeof(float));
+	};
+	plot("Frame time", frameTimesCopy, "ms", 0.0f, FLT_MAX);
+	plot("FSR2 GPU time", gpuTimesCopy, "ms", 0.0f, FLT_MAX);
+	plot("fMipBias", biasesCopy, "", -2.0f, 0.0f);
+
+	auto pipelines = PipelineCache::GetSingleton();
+	ImGui::TextUnformatted(Format("Pooled contexts {:.1f} MiB, pipeline cache {} hits / {} misses", double(ContextPool::GetSingleton()->GetPooledBytes()) / (1 << 20), pipelines->GetHits(), pipelines->GetMisses()), nullptr);
+
+	ImGui::TextUnformatted(Format("Effect uniforms bound to FSR2 state {}", EffectUniforms::GetSingleton()->GetBoundUniforms()), nullptr);
+	ImGui::TextUnformatted(Format("Settings loaded {} times", Config::GetSingleton()->GetReloads()), nullptr);
+
+	auto pacing = FramePacing::GetSingleton();
+	bool recordPacing = pacing->IsRecording();
+	if (ImGui::Checkbox("Record frame pacing", &recordPacing)) {
+		if (recordPacing)
+			pacing->StartRecording(outputDirectory / L"UpscalingFix.pacing.csv");
+		else
+			pacing->StopRecording();
+	}
+	if (recordPacing) {
+		const auto metrics = pacing->GetMetrics();
+		ImGui::TextUnformatted(Format("{} frames, median {:.2f} ms, stddev {:.2f} ms, {} spikes ({} near bias changes, {} near resets)",
+			metrics.frames, metrics.medianMilliseconds, metrics.stddevMilliseconds, metrics.spikes, metrics.spikesNearBiasChange, metrics.spikesNearReset), nullptr);
+	}
+
+	ImGui::Checkbox("Disable (for testing only)", &forceDisable);
+
+	auto capture = ABCapture::GetSingleton();
+	if (capture->IsCapturing()) {
+		if (ImGui::Button("Stop A/B capture", ImVec2(0, 0)))
+			capture->Stop();
+		ImGui::SameLine(0, -1);
+		ImGui::TextUnformatted(Format("{} pairs captured", capture->GetCapturedPairs()), nullptr);
+	} else if (ImGui::Button("Capture A/B pairs", ImVec2(0, 0))) {
+		capture->Start(outputDirectory / L"UpscalingFix.captures", ABCapture::DefaultPairs, forceDisable);
+	}
+
+	auto samplerBias = SamplerBias::GetSingleton();
+	bool samplerMode = samplerBias->enabled;
+	if (ImGui::Checkbox("Bias samplers instead of fMipBias", &samplerMode))
+		samplerBias->enabled = samplerMode;
+	if (samplerMode) {
+		bool geometryOnly = samplerBias->geometryOnly;
+		if (ImGui::Checkbox("Only in geometry passes", &geometryOnly))
+			samplerBias->geometryOnly = geometryOnly;
+	}
+
+	auto classifier = PassClassifier::GetSingleton();
+	using Pass = PassClassifier::Pass;
+	ImGui::TextUnformatted(Format("Draws: {} geometry, {} lighting, {} post, {} UI, {} other",
+		classifier->GetDraws(Pass::Geometry), classifier->GetDraws(Pass::Lighting), classifier->GetDraws(Pass::Post), classifier->GetDraws(Pass::UI), classifier->GetDraws(Pass::None)), nullptr);
+
+	size_t samplers, uniqueSamplers;
+	SamplerCache::GetSingleton()->GetCounts(samplers, uniqueSamplers);
+	ImGui::TextUnformatted(Format("Samplers {} ({} unique, dedup ratio {:.2f})", samplers, uniqueSamplers, uniqueSamplers ? double(samplers) / double(uniqueSamplers) : 0.0), nullptr);
+
+	auto eventLog = EventLog::GetSingleton();
+	uint64_t suppressed = 0;
+	for (size_t i = 0; i < static_cast<size_t>(EventLog::Event::Count); i++)
+		suppressed += eventLog->GetSuppressed(static_cast<EventLog::Event>(i));
+	ImGui::TextUnformatted(Format("Log events suppressed {}, dropped {}", suppressed, eventLog->GetDropped()), nullptr);
+	Worker::GetSingleton()->ForEachQueue([&](const Worker::Queue& workerQueue) {
+		ImGui::TextUnformatted(Format("Worker queue {}: {} jobs run, {} dropped", workerQueue.GetName(), workerQueue.GetRun(), workerQueue.GetDropped()), nullptr);
+	});
+
+	bool binaryLog = eventLog->binary;
+	if (ImGui::Checkbox("Binary event log", &binaryLog))
+		eventLog->binary = binaryLog;
+	if (binaryLog) {
+		ImGui::SameLine(0, -1);
+		ImGui::TextUnformatted(Format("{:.1f} KiB", double(eventLog->GetBinaryBytes()) / 1024), nullptr);
+	}
+
+	auto profiler = HookProfiler::GetSingleton();
+	bool telemetry = profiler->enabled;
+	if (ImGui::Checkbox("Hook telemetry", &telemetry))
+		profiler->enabled = telemetry;
+	if (telemetry) {
+		if (ImGui::Button("Export hook timings", ImVec2(0, 0)) && queue)
+			queue->Post([profiler, path = outputDirectory / L"UpscalingFix.hooks.json"] { profiler->Export(path); });
+		ImGui::SameLine(0, -1);
+		if (ImGui::Button("Reset", ImVec2(0, 0)))
+			profiler->Reset();
+	}
+
+	if (ImGui::CollapsingHeader("Metrics", 0))
+		DrawMetrics();
+}
+
+void Overlay::DrawMetrics()
+{
+	Metrics::ForEach([&](const Metrics::Metric& metric) {
+		switch (metric.GetKind()) {
+		case Metrics::Kind::Counter:
+			ImGui::TextUnformatted(Format("{} {}", metric.GetName(), static_cast<const Metrics::Counter&>(metric).Get()), nullptr);
+			break;
+		case Metrics::Kind::Gauge:
+			ImGui::TextUnformatted(Format("{} {:.3f} {}", metric.GetName(), static_cast<const Metrics::Gauge&>(metric).Get(), metric.GetUnit()), nullptr);
+			break;
+		case Metrics::Kind::Histogram:
+			{
+				const auto& histogram = static_cast<const Metrics::Histogram&>(metric);
+				const auto snapshot = histogram.Get();
+				ImGui::TextUnformatted(Format("{} {} samples, mean {:.3f} {}", metric.GetName(), snapshot.count, snapshot.Mean(), metric.GetUnit()), nullptr);
+
+				// Every histogram has at least one bound, see Metrics::Histogram
+				const auto last = histogram.GetBuckets() - 1;
+				char buckets[512] = "   ";
+				auto out = buckets + 3;
+				const auto end = buckets + std::size(buckets) - 1;
+				for (size_t i = 0; i < last; i++)
+					out = std::format_to_n(out, end - out, " <={} {} ", histogram.GetBound(i), snapshot.counts[i]).out;
+				out = std::format_to_n(out, end - out, " >{} {}", histogram.GetBound(last - 1), snapshot.counts[last]).out;
+				*out = '\0';
+				ImGui::TextUnformatted(buckets, out);
+				break;
+			}
+		}
+	});
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Worker.h"
+#include "ffx_fsr2.h"
+
+namespace reshade::api
+{
+	struct effect_runtime;
+}
+
+// The ReShade overlay: a small performance dashboard for the fix plus its debug controls.
+// Samples are recorded from the present and dispatch hooks into fixed rings, and all text is formatted
+// into member buffers, so drawing the overlay does not allocate.
+class Overlay
+{
+public:
+	static Overlay* GetSingleton()
+	{
+		static Overlay singleton;
+		return &singleton;
+	}
+
+	static constexpr size_t HistorySize = 256;
+
+	// Called once per presented frame.
+	void RecordPresent();
+
+	// Called whenever the bias is evaluated, from the FSR2 dispatch hook or from resolution detection.
+	void RecordBias(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias, bool fromDispatch);
+
+	// Called when the GPU time of an earlier FSR2 dispatch was read back.
+	void RecordGpuTime(float milliseconds);
+
+	// Directory that exported timings and recordings are written to.
+	void SetOutputDirectory(std::filesystem::path path) { outputDirectory = std::move(path); }
+
+	void Draw(reshade::api::effect_runtime* runtime, bool& forceDisable);
+
+private:
+	template <size_t N>
+	struct History
+	{
+		std::array<float, N> values{};
+		size_t next = 0;
+
+		void Push(float value)
+		{
+			values[next] = value;
+			next = (next + 1) % N;
+		}
+
+		float Latest() const { return values[(next + N - 1) % N]; }
+	};
+
+	Overlay() = default;
+
+	template <class... Args>
+	const char* Format(std::format_string<Args...> format, Args&&... args)
+	{
+		auto result = std::format_to_n(text, std::size(text) - 1, format, std::forward<Args>(args)...);
+		*result.out = '\0';
+		return text;
+	}
+
+	void UpdateDispatchRate();
+	void DrawMetrics();
+
+	std::mutex lock;
+	History<HistorySize> frameTimes;
+	History<HistorySize> biases;
+	History<HistorySize> gpuTimes;
+	std::chrono::steady_clock::time_point lastPresent;
+	FfxDimensions2D renderSize{};
+	FfxDimensions2D displaySize{};
+	uint64_t dispatches = 0;
+	bool detected = false;
+
+	// Only touched while drawing
+	uint64_t rateDispatches = 0;
+	std::chrono::steady_clock::time_point rateStart;
+	float dispatchRate = 0.0f;
+	char text[256]{};
+	char plotText[64]{};
+
+	std::filesystem::path outputDirectory;
+	Worker::Queue* queue = Worker::GetSingleton()->CreateQueue("overlay");
+};
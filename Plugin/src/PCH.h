@@ -55,6 +55,7 @@
 #include <iterator>
 #include <latch>
 #include <limits>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
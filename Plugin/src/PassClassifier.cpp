@@ -0,0 +1,121 @@
+#include "PassClassifier.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+using namespace reshade::api;
+
+namespace
+{
+	// Render targets bound on this thread, reclassified when the viewport narrows them down
+	struct ThreadState
+	{
+		command_list* cmdList = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t format = 0;
+		bool depth = false;
+		PassClassifier::Pass pass = PassClassifier::Pass::None;
+	};
+
+	thread_local ThreadState _state;
+
+	void OnBindRenderTargets(command_list* cmdList, uint32_t count, const resource_view* rtvs, resource_view dsv)
+	{
+		_state = { cmdList };
+
+		const auto view = count && rtvs[0].handle ? rtvs[0] : dsv;
+		if (!view.handle)
+			return;
+
+		const auto device = cmdList->get_device();
+		const auto desc = device->get_resource_desc(device->get_resource_from_view(view));
+		if (desc.type != resource_type::texture_2d)
+			return;
+
+		_state.width = desc.texture.width;
+		_state.height = desc.texture.height;
+		_state.format = count && rtvs[0].handle ? uint32_t(desc.texture.format) : 0;
+		_state.depth = dsv.handle != 0;
+		_state.pass = PassClassifier::GetSingleton()->Classify(_state.width, _state.height, _state.format, _state.depth);
+	}
+
+	void OnBindViewports(command_list* cmdList, uint32_t first, uint32_t count, const viewport* viewports)
+	{
+		if (cmdList != _state.cmdList || first != 0 || !count)
+			return;
+
+		// Dynamic resolution renders into a corner of display-sized targets
+		const auto width = std::min(uint32_t(viewports[0].width), _state.width);
+		const auto height = std::min(uint32_t(viewports[0].height), _state.height);
+		_state.pass = PassClassifier::GetSingleton()->Classify(width, height, _state.format, _state.depth);
+	}
+
+	bool OnDrawIndexed(command_list* cmdList, uint32_t, uint32_t, uint32_t, int32_t, uint32_t)
+	{
+		PassClassifier::GetSingleton()->CountDraw(cmdList == _state.cmdList ? _state.pass : PassClassifier::Pass::None);
+		return false;
+	}
+
+	bool OnDraw(command_list* cmdList, uint32_t, uint32_t, uint32_t, uint32_t)
+	{
+		PassClassifier::GetSingleton()->CountDraw(cmdList == _state.cmdList ? _state.pass : PassClassifier::Pass::None);
+		return false;
+	}
+}
+
+void PassClassifier::Register()
+{
+	reshade::register_event<reshade::addon_event::bind_render_targets_and_depth_stencil>(&OnBindRenderTargets);
+	reshade::register_event<reshade::addon_event::bind_viewports>(&OnBindViewports);
+	reshade::register_event<reshade::addon_event::draw_indexed>(&OnDrawIndexed);
+	reshade::register_event<reshade::addon_event::draw>(&OnDraw);
+}
+
+void PassClassifier::SetResolutions(FfxDimensions2D renderSize, FfxDimensions2D displaySize)
+{
+	resolutions.store(uint64_t(std::min(renderSize.width, 0xFFFFu)) << 48 | uint64_t(std::min(renderSize.height, 0xFFFFu)) << 32 |
+						  uint64_t(std::min(displaySize.width, 0xFFFFu)) << 16 | uint64_t(std::min(displaySize.height, 0xFFFFu)),
+		std::memory_order_relaxed);
+}
+
+PassClassifier::Pass PassClassifier::Classify(uint32_t width, uint32_t height, uint32_t format, bool depth) const
+{
+	const auto packed = resolutions.load(std::memory_order_relaxed);
+	const uint32_t renderWidth = uint32_t(packed >> 48), renderHeight = uint32_t(packed >> 32) & 0xFFFF;
+	const uint32_t displayWidth = uint32_t(packed >> 16) & 0xFFFF, displayHeight = uint32_t(packed) & 0xFFFF;
+
+	if (width == renderWidth && height == renderHeight && renderWidth != displayWidth)
+		return depth ? Pass::Geometry : Pass::Lighting;
+
+	if (width == displayWidth && height == displayHeight) {
+		// Without upscaling the scene renders at display resolution too, only the depth buffer tells it apart
+		if (renderWidth == displayWidth && depth)
+			return Pass::Geometry;
+
+		switch (static_cast<reshade::api::format>(format)) {
+		case format::r8g8b8a8_unorm:
+		case format::r8g8b8a8_unorm_srgb:
+		case format::b8g8r8a8_unorm:
+		case format::b8g8r8a8_unorm_srgb:
+		case format::r10g10b10a2_unorm:
+			return Pass::UI;
+		default:
+			return Pass::Post;
+		}
+	}
+
+	return Pass::None;
+}
+
+PassClassifier::Pass PassClassifier::GetCurrentPass()
+{
+	return _state.pass;
+}
+
+void PassClassifier::EndFrame()
+{
+	for (size_t i = 0; i < draws.size(); i++)
+		lastDraws[i] = draws[i].exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ffx_types.h"
+
+// Labels the pass each command list is currently recording from its render targets and viewport, so
+// other features can tell scene geometry apart from lighting, post-processing and UI. Render-resolution
+// passes with a depth buffer are geometry, render-resolution passes without one are lighting, and
+// display-resolution passes are post-processing, or UI when they write an 8-bit or 10-bit target.
+// Anything else, like shadow maps, is left unclassified.
+//
+// State is kept per recording thread and updated on every bind, so events never lock or allocate.
+// Draw counts per class are accumulated for the overlay and reset every frame.
+class PassClassifier
+{
+public:
+	static PassClassifier* GetSingleton()
+	{
+		static PassClassifier singleton;
+		return &singleton;
+	}
+
+	enum class Pass : uint8_t
+	{
+		None,
+		Geometry,
+		Lighting,
+		Post,
+		UI,
+
+		Count
+	};
+
+	void Register();
+
+	// Called whenever the bias is evaluated.
+	void SetResolutions(FfxDimensions2D renderSize, FfxDimensions2D displaySize);
+
+	// Pass the calling thread is recording, Pass::None outside of any known pass. Only meaningful on a
+	// thread that records command lists; device events such as sampler creation usually run elsewhere
+	// and see Pass::None.
+	static Pass GetCurrentPass();
+
+	// Called once per presented frame.
+	void EndFrame();
+
+	uint32_t GetDraws(Pass pass) const { return lastDraws[size_t(pass)]; }
+
+	// Used by the event handlers
+	Pass Classify(uint32_t width, uint32_t height, uint32_t format, bool depth) const;
+	void CountDraw(Pass pass) { draws[size_t(pass)].fetch_add(1, std::memory_order_relaxed); }
+
+private:
+	PassClassifier() = default;
+
+	std::atomic<uint64_t> resolutions = 0;  // render width, render height, display width, display height, 16 bit each
+	std::array<std::atomic<uint32_t>, size_t(Pass::Count)> draws{};
+	std::array<uint32_t, size_t(Pass::Count)> lastDraws{};
+};
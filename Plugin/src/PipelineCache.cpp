@@ -0,0 +1,99 @@
+#include "PipelineCache.h"
+
+#include "EventLog.h"
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+	// FNV-1a
+	auto bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+uint64_t PipelineCache::Hash(FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription)
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	hash = HashBytes(hash, &device, sizeof(device));
+	hash = HashBytes(hash, &passId, sizeof(passId));
+	hash = HashBytes(hash, &pipelineDescription->contextFlags, sizeof(pipelineDescription->contextFlags));
+	hash = HashBytes(hash, &pipelineDescription->samplerCount, sizeof(pipelineDescription->samplerCount));
+	if (pipelineDescription->samplers)
+		hash = HashBytes(hash, pipelineDescription->samplers, pipelineDescription->samplerCount * sizeof(FfxFilterType));
+	hash = HashBytes(hash, &pipelineDescription->rootConstantBufferCount, sizeof(pipelineDescription->rootConstantBufferCount));
+	if (pipelineDescription->rootConstantBufferSizes)
+		hash = HashBytes(hash, pipelineDescription->rootConstantBufferSizes, pipelineDescription->rootConstantBufferCount * sizeof(uint32_t));
+	return hash;
+}
+
+bool PipelineCache::Matches(const Cached& cached, FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription)
+{
+	if (cached.device != device || cached.passId != passId || cached.contextFlags != pipelineDescription->contextFlags)
+		return false;
+	if (cached.samplers.size() != pipelineDescription->samplerCount || cached.rootConstantBufferSizes.size() != pipelineDescription->rootConstantBufferCount)
+		return false;
+	return std::equal(cached.samplers.begin(), cached.samplers.end(), pipelineDescription->samplers) &&
+	       std::equal(cached.rootConstantBufferSizes.begin(), cached.rootConstantBufferSizes.end(), pipelineDescription->rootConstantBufferSizes);
+}
+
+FfxErrorCode PipelineCache::Create(FfxFsr2Interface* backendInterface, FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline, FfxFsr2CreatePipelineFunc original)
+{
+	if (!pipelineDescription || !outPipeline)
+		return original(backendInterface, passId, pipelineDescription, outPipeline);
+
+	std::lock_guard guard(lock);
+
+	const auto hash = Hash(device, passId, pipelineDescription);
+	for (auto& cached : pipelines) {
+		if (cached.hash == hash && Matches(cached, device, passId, pipelineDescription)) {
+			*outPipeline = cached.state;
+			hits++;
+			savedMilliseconds += cached.createMilliseconds;
+			DEBUG("Reused cached FSR2 pipeline for pass {} ({:016X})", static_cast<int>(passId), hash);
+			return FFX_OK;
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = original(backendInterface, passId, pipelineDescription, outPipeline);
+	const auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	if (result != FFX_OK) {
+		EventLog::GetSingleton()->Post<EventLog::Event::PipelineCreateFailed>(static_cast<int>(passId), static_cast<uint32_t>(result));
+		return result;
+	}
+
+	INFO("Created FSR2 pipeline for pass {} in {:.2f} ms ({:016X})", static_cast<int>(passId), milliseconds, hash);
+	misses++;
+
+	auto& cached = pipelines.emplace_back();
+	cached.hash = hash;
+	cached.device = device;
+	cached.passId = passId;
+	cached.contextFlags = pipelineDescription->contextFlags;
+	if (pipelineDescription->samplers)
+		cached.samplers.assign(pipelineDescription->samplers, pipelineDescription->samplers + pipelineDescription->samplerCount);
+	if (pipelineDescription->rootConstantBufferSizes)
+		cached.rootConstantBufferSizes.assign(pipelineDescription->rootConstantBufferSizes, pipelineDescription->rootConstantBufferSizes + pipelineDescription->rootConstantBufferCount);
+	cached.state = *outPipeline;
+	cached.createMilliseconds = milliseconds;
+
+	return result;
+}
+
+size_t PipelineCache::Flush(FfxDevice device, FfxFsr2Interface* backendInterface, FfxFsr2DestroyPipelineFunc destroy)
+{
+	std::lock_guard guard(lock);
+
+	const auto flushed = std::ranges::partition(pipelines, [&](const Cached& cached) { return cached.device != device; });
+	for (auto& cached : flushed)
+		destroy(backendInterface, &cached.state);
+
+	const auto count = flushed.size();
+	pipelines.erase(flushed.begin(), flushed.end());
+	if (count)
+		INFO("Destroyed {} cached FSR2 pipelines of device {:X}", count, reinterpret_cast<uintptr_t>(device));
+	return count;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ffx_fsr2.h"
+
+// Cache of FSR2 pipelines per device, keyed by a content hash of the device, the pass and its
+// FfxPipelineDescription. Every context the game creates asks for the same handful of permutations, so
+// only the first creation pays for root signature and PSO compilation. Cached pipelines are owned by the
+// cache until their device goes away: the context pool flushes a device once it releases the last pooled
+// context on it, which it also does when ReShade reports the device destroyed.
+class PipelineCache
+{
+public:
+	static PipelineCache* GetSingleton()
+	{
+		static PipelineCache singleton;
+		return &singleton;
+	}
+
+	FfxErrorCode Create(FfxFsr2Interface* backendInterface, FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription, FfxPipelineState* outPipeline, FfxFsr2CreatePipelineFunc original);
+
+	// Destroys every pipeline cached for device through a backend of that device. Returns how many.
+	size_t Flush(FfxDevice device, FfxFsr2Interface* backendInterface, FfxFsr2DestroyPipelineFunc destroy);
+
+	size_t GetHits() const { return hits; }
+	size_t GetMisses() const { return misses; }
+	size_t GetCached() const { return pipelines.size(); }
+	double GetSavedMilliseconds() const { return savedMilliseconds; }
+
+private:
+	struct Cached
+	{
+		uint64_t hash;
+		FfxDevice device;
+		FfxFsr2Pass passId;
+		uint32_t contextFlags;
+		std::vector<FfxFilterType> samplers;
+		std::vector<uint32_t> rootConstantBufferSizes;
+		FfxPipelineState state;
+		double createMilliseconds;
+	};
+
+	PipelineCache() = default;
+
+	static uint64_t Hash(FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription);
+	static bool Matches(const Cached& cached, FfxDevice device, FfxFsr2Pass passId, const FfxPipelineDescription* pipelineDescription);
+
+	std::mutex lock;
+	std::vector<Cached> pipelines;
+	size_t hits = 0;
+	size_t misses = 0;
+	double savedMilliseconds = 0.0;
+};
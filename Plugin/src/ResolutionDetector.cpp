@@ -0,0 +1,62 @@
+#include "ResolutionDetector.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+using namespace reshade::api;
+
+namespace
+{
+	bool OnCreateSwapchain(swapchain_desc& desc, void*)
+	{
+		ResolutionDetector::GetSingleton()->SetDisplaySize(desc.texture.width, desc.texture.height);
+		return false;
+	}
+
+	void OnBindRenderTargets(command_list* cmdList, uint32_t, const resource_view*, resource_view dsv)
+	{
+		if (!dsv.handle)
+			return;
+
+		const auto device = cmdList->get_device();
+		const auto desc = device->get_resource_desc(device->get_resource_from_view(dsv));
+		if (desc.type != resource_type::texture_2d)
+			return;
+
+		ResolutionDetector::GetSingleton()->CountBind(desc.texture.width, desc.texture.height);
+	}
+}
+
+void ResolutionDetector::Register()
+{
+	reshade::register_event<reshade::addon_event::create_swapchain>(&OnCreateSwapchain);
+	reshade::register_event<reshade::addon_event::bind_render_targets_and_depth_stencil>(&OnBindRenderTargets);
+}
+
+FfxDimensions2D ResolutionDetector::GetDisplaySize() const
+{
+	const auto packed = displaySize.load(std::memory_order_relaxed);
+	return { uint32_t(packed >> 32), uint32_t(packed) };
+}
+
+void ResolutionDetector::EndFrame(effect_runtime* runtime)
+{
+	auto display = GetDisplaySize();
+	if (!display.height) {
+		// The addon may be registered after the swap chain was created
+		runtime->get_screenshot_width_and_height(&display.width, &display.height);
+		SetDisplaySize(display.width, display.height);
+	}
+
+	tracker.EndFrame(display);
+}
+
+bool ResolutionDetector::GetDetected(FfxDimensions2D& renderSize, FfxDimensions2D& displaySize) const
+{
+	if (!tracker.GetRenderSize(renderSize))
+		return false;
+
+	displaySize = GetDisplaySize();
+	return true;
+}
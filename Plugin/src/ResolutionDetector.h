@@ -0,0 +1,42 @@
+#pragma once
+
+#include "RenderExtentTracker.h"
+
+namespace reshade::api
+{
+	struct effect_runtime;
+}
+
+// Infers render and display resolution from what the game actually renders to, for upscalers other than
+// FSR2 and for native resolution with a render scale. The display size comes from the swap chain, the render
+// size from the depth-stencil binds RenderExtentTracker counts.
+class ResolutionDetector
+{
+public:
+	static ResolutionDetector* GetSingleton()
+	{
+		static ResolutionDetector singleton;
+		return &singleton;
+	}
+
+	void Register();
+
+	void SetDisplaySize(uint32_t width, uint32_t height) { displaySize.store(uint64_t(width) << 32 | height, std::memory_order_relaxed); }
+
+	// Counts one depth-stencil bind at this extent. Lock-free and allocation-free.
+	void CountBind(uint32_t width, uint32_t height) { tracker.CountBind(width, height); }
+
+	// Called once per presented frame. Picks this frame's render size and clears the histogram.
+	void EndFrame(reshade::api::effect_runtime* runtime);
+
+	// Returns false while no render size is stable.
+	bool GetDetected(FfxDimensions2D& renderSize, FfxDimensions2D& displaySize) const;
+
+private:
+	ResolutionDetector() = default;
+
+	FfxDimensions2D GetDisplaySize() const;
+
+	RenderExtentTracker tracker;
+	std::atomic<uint64_t> displaySize = 0;  // width, height, 32 bit each
+};
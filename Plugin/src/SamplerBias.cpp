@@ -0,0 +1,212 @@
+#include "SamplerBias.h"
+
+#include "PassClassifier.h"
+#include "SamplerCache.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+#include <d3d12.h>
+
+using namespace reshade::api;
+
+namespace
+{
+	// CPU handle of the first descriptor of a copy range, 0 if ReShade does not know its heap
+	SIZE_T GetRangeStart(device* device, descriptor_set set, uint32_t binding, uint32_t arrayOffset, UINT increment, D3D12_DESCRIPTOR_HEAP_TYPE& type)
+	{
+		// In D3D12 the binding is the offset in descriptors from the start of the set
+		descriptor_pool pool;
+		uint32_t offset;
+		device->get_descriptor_pool_offset(set, binding + arrayOffset, 0, &pool, &offset);
+		if (!pool.handle)
+			return 0;
+
+		const auto heap = reinterpret_cast<ID3D12DescriptorHeap*>(pool.handle);
+		type = heap->GetDesc().Type;
+		return heap->GetCPUDescriptorHandleForHeapStart().ptr + SIZE_T(offset) * increment;
+	}
+
+	bool OnCopyDescriptorSets(device* device, uint32_t count, const descriptor_set_copy* copies)
+	{
+		return SamplerBias::GetSingleton()->Copy(device, count, copies);
+	}
+
+	void OnDestroyDevice(device* device)
+	{
+		SamplerBias::GetSingleton()->ReleaseDevice(device);
+	}
+}
+
+void SamplerBias::Register()
+{
+	reshade::register_event<reshade::addon_event::copy_descriptor_sets>(&OnCopyDescriptorSets);
+	reshade::register_event<reshade::addon_event::destroy_device>(&OnDestroyDevice);
+}
+
+float SamplerBias::Apply(sampler_desc& desc) const
+{
+	const float bias = appliedBias.load(std::memory_order_relaxed);
+	desc.mip_lod_bias += bias;
+	return bias;
+}
+
+bool SamplerBias::Copy(device* device, uint32_t count, const descriptor_set_copy* copies)
+{
+	if (device->get_api() != device_api::d3d12)
+		return false;
+
+	// Pinned for the whole call, nothing below locks. A table older than the last change to the biased
+	// samplers may map a slot the game has since written with another sampler, those copies are left
+	// alone until the next frame publishes a current one.
+	const auto stale = staleSamplers.Read();
+	if (!stale->Size() || stale->GetVersion() != SamplerCache::GetSingleton()->GetVersion())
+		return false;
+
+	const auto increment = reinterpret_cast<ID3D12Device*>(device->get_native())->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+	const auto deviceKey = reinterpret_cast<uint64_t>(device);
+
+	// Copies are made on the recording thread, so unlike at creation the pass is known here
+	const auto pass = PassClassifier::GetCurrentPass();
+	const bool unbiased = geometryOnly.load(std::memory_order_relaxed) && pass != PassClassifier::Pass::None && pass != PassClassifier::Pass::Geometry;
+
+	// A copy is either made here in full or left to the game, so every range is checked before the first is
+	// made. Copies without a stale sampler are left to the game as well.
+	auto getSource = [&](const descriptor_set_copy& copy, SIZE_T& source) {
+		D3D12_DESCRIPTOR_HEAP_TYPE sourceType{}, destType{};
+		source = GetRangeStart(device, copy.source_set, copy.source_binding, copy.source_array_offset, increment, sourceType);
+		const auto dest = GetRangeStart(device, copy.dest_set, copy.dest_binding, copy.dest_array_offset, increment, destType);
+		return source && dest && sourceType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER && destType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
+	};
+	SIZE_T source;
+	size_t found = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (!getSource(copies[i], source))
+			return false;
+		found += stale->ForEachStale(deviceKey, source, increment, copies[i].count, unbiased, [](uint32_t, uint64_t) {});
+	}
+	if (!found)
+		return false;
+
+	// The game's copy, then the stale samplers written over it with the bias of the pass. The game only copies
+	// into slots the GPU no longer reads, so these writes are as safe as the copy itself.
+	device->copy_descriptor_sets(count, copies);
+
+	constexpr size_t Batch = 64;
+	std::array<descriptor_set_update, Batch> updates;
+	std::array<sampler, Batch> samplers;
+	size_t pending = 0;
+	auto flush = [&] {
+		device->update_descriptor_sets(static_cast<uint32_t>(pending), updates.data());
+		pending = 0;
+	};
+	for (uint32_t i = 0; i < count; i++) {
+		const auto& copy = copies[i];
+		getSource(copy, source);
+		stale->ForEachStale(deviceKey, source, increment, copy.count, unbiased, [&](uint32_t index, uint64_t replacement) {
+			// In D3D12 the binding is the offset in descriptors from the start of the set
+			samplers[pending] = { replacement };
+			updates[pending] = { copy.dest_set, copy.dest_binding + copy.dest_array_offset + index, 0, 1, descriptor_type::sampler, &samplers[pending] };
+			if (++pending == Batch)
+				flush();
+		});
+	}
+	if (pending)
+		flush();
+
+	rewrites.fetch_add(found, std::memory_order_relaxed);
+	return true;
+}
+
+void SamplerBias::ReleaseDevice(device* device)
+{
+	std::lock_guard guard(replacementsLock);
+	std::erase_if(replacements, [&](const Replacement& replacement) {
+		if (replacement.device != device)
+			return false;
+		device->destroy_sampler(replacement.handle);
+		return true;
+	});
+}
+
+bool SamplerBias::ShouldBias(const sampler_desc& desc)
+{
+	const auto filter = static_cast<uint32_t>(desc.filter);
+
+	// Comparison samplers are used for shadow maps, which are not rendered at the upscaled resolution
+	if (filter & 0x80)
+		return false;
+
+	return desc.filter == filter_mode::anisotropic || (filter & 0x10) || (filter & 0x1);
+}
+
+void SamplerBias::ApplyPending()
+{
+	const float bias = enabled.load(std::memory_order_relaxed) ? targetBias.load(std::memory_order_relaxed) : 0.0f;
+	if (bias != appliedBias.load(std::memory_order_relaxed)) {
+		appliedBias.store(bias, std::memory_order_relaxed);
+		DEBUG("Sampler LOD bias set to {}, {} samplers rewritten at copies so far", bias, rewrites.load(std::memory_order_relaxed));
+	}
+
+	PublishStale(bias, enabled.load(std::memory_order_relaxed) && geometryOnly.load(std::memory_order_relaxed));
+}
+
+void SamplerBias::PublishStale(float bias, bool unbiasedPasses)
+{
+	auto cache = SamplerCache::GetSingleton();
+	const auto version = cache->GetVersion();
+	if (version == publishedVersion && bias == publishedBias && unbiasedPasses == publishedGeometryOnly)
+		return;
+
+	struct Stale
+	{
+		reshade::api::device* device;
+		sampler_desc desc;
+		uint64_t handle;
+		bool biased;    // written with another bias than the current one
+		bool unbiased;  // written with a bias that passes outside of geometry must not have
+	};
+	std::vector<Stale> found;
+	cache->ForEachBiased([&](device* device, const sampler_desc& desc, uint64_t handle, float writtenBias) {
+		const bool biased = writtenBias != bias;
+		const bool unbiased = unbiasedPasses && writtenBias != 0.0f;
+		if (biased || unbiased)
+			found.push_back({ device, desc, handle, biased, unbiased });
+	});
+
+	std::vector<StaleSamplers::Sampler> samplers;
+	samplers.reserve(found.size());
+	{
+		// Held while creating so a device cannot go away in between
+		std::lock_guard guard(replacementsLock);
+		for (const auto& stale : found) {
+			const auto biased = stale.biased ? GetReplacement(stale.device, stale.desc, bias) : 0;
+			const auto unbiased = stale.unbiased ? GetReplacement(stale.device, stale.desc, 0.0f) : 0;
+			if (biased || unbiased)
+				samplers.push_back({ reinterpret_cast<uint64_t>(stale.device), stale.handle, biased, unbiased });
+		}
+	}
+
+	staleSamplers.Publish(std::make_unique<StaleSamplers>(version, std::move(samplers)));
+	staleSamplers.Reclaim();
+	publishedVersion = version;
+	publishedBias = bias;
+	publishedGeometryOnly = unbiasedPasses;
+}
+
+uint64_t SamplerBias::GetReplacement(device* device, sampler_desc desc, float bias)
+{
+	desc.mip_lod_bias += bias;
+	for (const auto& replacement : replacements) {
+		if (replacement.device == device && std::memcmp(&replacement.desc, &desc, sizeof(desc)) == 0)
+			return replacement.handle.handle;
+	}
+
+	// Created through ReShade in its own descriptor heap, copied from by update_descriptor_sets
+	sampler handle;
+	if (!device->create_sampler(desc, &handle))
+		return 0;
+	replacements.push_back({ device, desc, handle });
+	return handle.handle;
+}
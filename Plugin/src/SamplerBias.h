@@ -0,0 +1,93 @@
+#pragma once
+
+#include "SnapshotCell.h"
+#include "StaleSamplers.h"
+
+#include <reshade/reshade_api_resource.hpp>
+
+namespace reshade::api
+{
+	struct device;
+	struct descriptor_set_copy;
+}
+
+// Alternative to writing fMipBias: adds the bias to the LOD bias of every linear and anisotropic sampler
+// the game creates, so texture LOD is correct for every upscaler path regardless of whether the engine
+// reads the INI setting. Whether a sampler is biased is decided when it is created, by its filter.
+//
+// The game's own sampler descriptors are never rewritten after creation, the GPU may still be reading
+// copies of them. When the bias changes, a biased sampler is written with the new bias where the game
+// copies it into a shader-visible heap instead, since the game itself only copies into slots the GPU
+// is done with. ApplyPending creates a sampler with the new bias per distinct descriptor through ReShade
+// and publishes a StaleSamplers table of the handles it replaces; Copy reads the table without locking,
+// makes the game's copy through ReShade and writes the replacements over it with update_descriptor_sets.
+// The copy is also where a sampler meets a pass, so that is where geometryOnly writes it without bias.
+// Samplers the game creates straight into a shader-visible heap are never copied and keep the bias they
+// were created with.
+class SamplerBias
+{
+public:
+	static SamplerBias* GetSingleton()
+	{
+		static SamplerBias singleton;
+		return &singleton;
+	}
+
+	std::atomic<bool> enabled = false;
+
+	// Writes biased samplers without bias where they are copied while a lighting, post-processing or UI pass
+	// is recording. Samplers are created on the device outside of any pass, copies are made on the thread
+	// recording the pass, see PassClassifier::GetCurrentPass. Copies made before a pass binds its render
+	// targets count towards the pass recorded before them.
+	std::atomic<bool> geometryOnly = true;
+
+	// Requests a new bias from any thread. Takes effect at the next ApplyPending.
+	void SetBias(float bias) { targetBias.store(bias, std::memory_order_relaxed); }
+
+	void Register();
+
+	// Called once per frame. Switches to the requested bias if it or the mode changed, and publishes the
+	// samplers written with another bias if they changed since the last frame.
+	void ApplyPending();
+
+	// Adds the current bias to a sampler ShouldBias selected. Returns the bias added, 0 if none.
+	float Apply(reshade::api::sampler_desc& desc) const;
+
+	// Called from copy_descriptor_sets. Returns true if it made the copies itself.
+	bool Copy(reshade::api::device* device, uint32_t count, const reshade::api::descriptor_set_copy* copies);
+
+	// Called from destroy_device. Destroys the replacement samplers created on it.
+	void ReleaseDevice(reshade::api::device* device);
+
+	static bool ShouldBias(const reshade::api::sampler_desc& desc);
+
+private:
+	struct Replacement
+	{
+		reshade::api::device* device;
+		reshade::api::sampler_desc desc;  // with the bias added
+		reshade::api::sampler handle;
+	};
+
+	SamplerBias() = default;
+
+	void PublishStale(float bias, bool unbiasedPasses);
+	uint64_t GetReplacement(reshade::api::device* device, reshade::api::sampler_desc desc, float bias);
+
+	std::atomic<float> targetBias = 0.0f;
+	std::atomic<float> appliedBias = 0.0f;  // 0 while disabled
+	std::atomic<uint64_t> rewrites = 0;  // stale samplers written at copies
+
+	const StaleSamplers noStaleSamplers;
+	SnapshotCell<StaleSamplers> staleSamplers{ &noStaleSamplers };
+
+	// Present thread only
+	uint64_t publishedVersion = 0;
+	float publishedBias = 0.0f;
+	bool publishedGeometryOnly = false;
+
+	// Kept until their device goes away, published tables may still point at them and toggling between
+	// resolutions reuses them
+	std::mutex replacementsLock;
+	std::vector<Replacement> replacements;
+};
@@ -0,0 +1,133 @@
+#include "SamplerCache.h"
+
+#include "SamplerBias.h"
+
+#define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
+#include <imgui.h>
+#include <reshade/reshade.hpp>
+
+using namespace reshade::api;
+
+static_assert(sizeof(sampler_desc) == 13 * sizeof(uint32_t), "sampler_desc is hashed and compared bytewise, it must not contain padding");
+
+namespace
+{
+	// create_sampler sees the original descriptor, init_sampler the handle, both on the same thread
+	thread_local sampler_desc _pendingDesc;
+	thread_local bool _pendingBiased = false;
+	thread_local float _pendingBias = 0.0f;
+	thread_local bool _pending = false;
+
+	bool OnCreateSampler(device*, sampler_desc& desc)
+	{
+		const auto samplerBias = SamplerBias::GetSingleton();
+		_pendingDesc = desc;
+		_pendingBiased = SamplerBias::ShouldBias(desc);
+		_pendingBias = _pendingBiased ? samplerBias->Apply(desc) : 0.0f;
+		_pending = true;
+		return _pendingBias != 0.0f;
+	}
+
+	void OnInitSampler(device* device, const sampler_desc& desc, sampler handle)
+	{
+		if (_pending)
+			SamplerCache::GetSingleton()->Insert(device, handle, _pendingDesc, _pendingBiased, _pendingBias);
+		else
+			SamplerCache::GetSingleton()->Insert(device, handle, desc, false, 0.0f);
+		_pending = false;
+	}
+
+	void OnDestroySampler(device*, sampler handle)
+	{
+		SamplerCache::GetSingleton()->Remove(handle);
+	}
+
+	void OnDestroyDevice(device* device)
+	{
+		SamplerCache::GetSingleton()->RemoveDevice(device);
+	}
+}
+
+size_t SamplerCache::KeyHash::operator()(const Key& key) const
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	auto hashBytes = [&](const void* data, size_t size) {
+		for (size_t i = 0; i < size; i++) {
+			hash ^= static_cast<const uint8_t*>(data)[i];
+			hash *= 0x100000001b3;
+		}
+	};
+	hashBytes(&key.device, sizeof(key.device));
+	hashBytes(&key.desc, sizeof(key.desc));
+	hashBytes(&key.biased, sizeof(key.biased));
+	return static_cast<size_t>(hash);
+}
+
+void SamplerCache::Register()
+{
+	reshade::register_event<reshade::addon_event::create_sampler>(&OnCreateSampler);
+	reshade::register_event<reshade::addon_event::init_sampler>(&OnInitSampler);
+	reshade::register_event<reshade::addon_event::destroy_sampler>(&OnDestroySampler);
+	reshade::register_event<reshade::addon_event::destroy_device>(&OnDestroyDevice);
+}
+
+void SamplerCache::Insert(device* device, sampler handle, const sampler_desc& desc, bool biased, float bias)
+{
+	std::lock_guard guard(lock);
+
+	// D3D12 descriptor slots are overwritten without being destroyed first
+	RemoveLocked(handle.handle);
+
+	const Key key{ device, desc, biased };
+	auto [it, inserted] = entries.try_emplace(key, Entry{ device, desc, biased, {} });
+	it->second.handles.push_back(handle.handle);
+	handles.emplace(handle.handle, Handle{ key, bias });
+	if (biased)
+		version.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SamplerCache::Remove(sampler handle)
+{
+	std::lock_guard guard(lock);
+	RemoveLocked(handle.handle);
+}
+
+void SamplerCache::RemoveDevice(device* device)
+{
+	std::lock_guard guard(lock);
+	for (auto it = handles.begin(); it != handles.end();) {
+		const auto next = std::next(it);
+		if (it->second.key.device == device)
+			RemoveLocked(it->first);
+		it = next;
+	}
+}
+
+void SamplerCache::RemoveLocked(uint64_t handle)
+{
+	const auto it = handles.find(handle);
+	if (it == handles.end())
+		return;
+
+	const auto& key = it->second.key;
+	if (key.biased)
+		version.fetch_add(1, std::memory_order_relaxed);
+
+	const auto entry = entries.find(key);
+	if (entry != entries.end()) {
+		auto& entryHandles = entry->second.handles;
+		entryHandles.erase(std::find(entryHandles.begin(), entryHandles.end(), handle));
+		if (entryHandles.empty())
+			entries.erase(entry);
+	}
+
+	handles.erase(it);
+}
+
+void SamplerCache::GetCounts(size_t& samplers, size_t& unique)
+{
+	std::lock_guard guard(lock);
+	samplers = handles.size();
+	unique = entries.size();
+}
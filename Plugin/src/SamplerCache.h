@@ -0,0 +1,96 @@
+#pragma once
+
+#include <reshade/reshade_api_resource.hpp>
+
+namespace reshade::api
+{
+	struct device;
+}
+
+// Tracks every sampler the game creates by content. Identical descriptors share one reference-counted
+// entry that lists every handle written with it, which is what the overlay reports as the dedup ratio.
+// ReShade cannot hand the game a different handle than the one it asked for, since in D3D12 the handle is
+// the game's own descriptor slot, so sharing happens on the work done per sampler instead: SamplerBias
+// reads the original descriptors of biased handles here rather than keeping its own copies.
+class SamplerCache
+{
+public:
+	static SamplerCache* GetSingleton()
+	{
+		static SamplerCache singleton;
+		return &singleton;
+	}
+
+	struct Entry
+	{
+		reshade::api::device* device;
+		reshade::api::sampler_desc desc;  // as created by the game, before any bias
+		bool biased;                      // selected by SamplerBias at creation
+		std::vector<uint64_t> handles;
+	};
+
+	void Register();
+
+	// desc is the descriptor before any bias, bias what SamplerBias added to the one written to the handle.
+	void Insert(reshade::api::device* device, reshade::api::sampler handle, const reshade::api::sampler_desc& desc, bool biased, float bias);
+	void Remove(reshade::api::sampler handle);
+
+	// Forgets every sampler of a device that is going away.
+	void RemoveDevice(reshade::api::device* device);
+
+	// Changes whenever a biased sampler is added, overwritten or removed. Lock-free.
+	uint64_t GetVersion() const { return version.load(std::memory_order_relaxed); }
+
+	// Calls func(device, desc, handle, bias) for every live biased sampler, bias being what was added to desc
+	// when the handle was written.
+	template <class Func>
+	void ForEachBiased(Func&& func)
+	{
+		std::lock_guard guard(lock);
+		for (auto& [handle, value] : handles) {
+			if (value.key.biased)
+				func(value.key.device, value.key.desc, handle, value.bias);
+		}
+	}
+
+	template <class Func>
+	void ForEach(Func&& func)
+	{
+		std::lock_guard guard(lock);
+		for (auto& [key, entry] : entries)
+			func(entry);
+	}
+
+	// Number of live sampler handles and of distinct descriptors among them.
+	void GetCounts(size_t& samplers, size_t& unique);
+
+private:
+	struct Key
+	{
+		reshade::api::device* device;
+		reshade::api::sampler_desc desc;
+		bool biased;
+
+		bool operator==(const Key& other) const { return device == other.device && biased == other.biased && std::memcmp(&desc, &other.desc, sizeof(desc)) == 0; }
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Handle
+	{
+		Key key;
+		float bias;
+	};
+
+	SamplerCache() = default;
+
+	void RemoveLocked(uint64_t handle);
+
+	std::mutex lock;
+	std::unordered_map<Key, Entry, KeyHash> entries;
+	std::unordered_map<uint64_t, Handle> handles;
+	std::atomic<uint64_t> version = 0;
+};
@@ -0,0 +1,136 @@
+#include "Worker.h"
+
+bool Worker::Queue::RunAll()
+{
+	bool ran = false;
+	Job job;
+	while (ring.Pop(job)) {
+		job();
+		job = nullptr;
+		run.fetch_add(1, std::memory_order_relaxed);
+		ran = true;
+	}
+	return ran;
+}
+
+void Worker::Queue::DropAll()
+{
+	Job job;
+	while (ring.Pop(job)) {
+		job = nullptr;
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Worker::Start()
+{
+	if (started.exchange(true))
+		return;
+
+	running = Threads;
+	for (size_t i = 0; i < Threads; i++)
+		std::thread(&Worker::Run, this, i).detach();
+}
+
+void Worker::Shutdown(bool processTerminating)
+{
+	if (!started || stopping.exchange(true))
+		return;
+
+	{
+		std::lock_guard guard(wakeLock);
+	}
+	wake.notify_all();
+
+	// Threads cannot be joined under the loader lock, but leaving their loop needs no lock. When the process
+	// is terminating they were killed already and the queues are ours.
+	if (!processTerminating) {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (running.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(PollInterval);
+	}
+
+	if (processTerminating) {
+		ForEachQueue([](Queue& queue) { queue.DropAll(); });
+	} else if (running.load(std::memory_order_acquire)) {
+		// A thread still inside a job is still the consumer of its queues and runs the periodic tasks, the
+		// caller can neither drain nor drop them without racing it. They are left as they are.
+		ERROR("Worker threads still busy after 1 s, leaving their queued jobs and periodic tasks unrun");
+		return;
+	} else {
+		RunQueues(0, 1);
+	}
+	RunTasks(true);
+}
+
+Worker::Queue* Worker::CreateQueue(const char* name)
+{
+	std::lock_guard guard(lock);
+
+	const auto count = queueCount.load(std::memory_order_relaxed);
+	if (count == MaxQueues) {
+		ERROR("Too many worker queues, {} runs on the caller", name);
+		return nullptr;
+	}
+
+	queues[count] = std::make_unique<Queue>(name);
+	queueCount.store(count + 1, std::memory_order_release);
+	return queues[count].get();
+}
+
+void Worker::Every(std::chrono::milliseconds interval, Job task)
+{
+	std::lock_guard guard(lock);
+
+	const auto count = taskCount.load(std::memory_order_relaxed);
+	if (count == MaxTasks) {
+		ERROR("Too many periodic worker tasks");
+		return;
+	}
+
+	tasks[count] = { interval, std::move(task), std::chrono::steady_clock::now() + interval };
+	taskCount.store(count + 1, std::memory_order_release);
+}
+
+void Worker::Run(size_t thread)
+{
+	while (!stopping.load(std::memory_order_acquire)) {
+		bool ran = RunQueues(thread, Threads);
+		if (thread == 0)
+			ran |= RunTasks(false);
+
+		if (!ran) {
+			// Posting never signals, the render thread should not pay for a wakeup
+			std::unique_lock guard(wakeLock);
+			wake.wait_for(guard, PollInterval, [&] { return stopping.load(std::memory_order_relaxed); });
+		}
+	}
+
+	running.fetch_sub(1, std::memory_order_release);
+}
+
+bool Worker::RunQueues(size_t thread, size_t stride)
+{
+	bool ran = false;
+	const auto count = queueCount.load(std::memory_order_acquire);
+	for (size_t i = thread; i < count; i += stride)
+		ran |= queues[i]->RunAll();
+	return ran;
+}
+
+bool Worker::RunTasks(bool all)
+{
+	bool ran = false;
+	const auto now = std::chrono::steady_clock::now();
+	const auto count = taskCount.load(std::memory_order_acquire);
+	for (size_t i = 0; i < count; i++) {
+		auto& task = tasks[i];
+		if (!all && now < task.due)
+			continue;
+
+		task.run();
+		task.due = now + task.interval;
+		ran = true;
+	}
+	return ran;
+}
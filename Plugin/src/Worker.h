@@ -0,0 +1,106 @@
+#pragma once
+
+#include "InplaceFunction.h"
+#include "SpscRing.h"
+
+// Background job service shared by every subsystem, so nothing heavier than an atomic store happens in the
+// hooks and no subsystem runs a thread of its own. Each producer creates its own Queue, a bounded
+// single-producer ring that must only be posted to from one thread; a full queue drops the job and counts
+// it. Jobs of one queue run in order on one worker thread. Periodic tasks run on the first worker thread.
+// Jobs are stored inline in the ring, a capture larger than JobSize has to be boxed by the caller.
+// Shutdown runs whatever is still queued and every periodic task once more on the calling thread, except
+// when the process is terminating: the worker threads were killed wherever they were, so queued jobs are
+// dropped rather than run against state those threads may have left half updated. Should a worker thread
+// not leave its loop within a second, its queues are still its own and everything queued is left unrun.
+class Worker
+{
+public:
+	static Worker* GetSingleton()
+	{
+		static Worker singleton;
+		return &singleton;
+	}
+
+	// Fits a pointer next to a std::filesystem::path
+	static constexpr size_t JobSize = 48;
+	using Job = InplaceFunction<JobSize>;
+
+	static constexpr size_t Threads = 2;
+	static constexpr size_t MaxQueues = 16;
+	static constexpr size_t MaxTasks = 16;
+	static constexpr size_t QueueCapacity = 256;
+	static constexpr auto PollInterval = std::chrono::milliseconds(2);
+
+	class Queue
+	{
+	public:
+		explicit Queue(const char* name) :
+			name(name) {}
+
+		bool Post(Job job)
+		{
+			if (ring.Push(std::move(job)))
+				return true;
+
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		const char* GetName() const { return name; }
+		uint64_t GetRun() const { return run.load(std::memory_order_relaxed); }
+		uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+	private:
+		friend class Worker;
+
+		bool RunAll();
+		void DropAll();
+
+		const char* name;
+		SpscRing<Job, QueueCapacity> ring;
+		std::atomic<uint64_t> run = 0;
+		std::atomic<uint64_t> dropped = 0;
+	};
+
+	void Start();
+
+	// processTerminating is DllMain's lpReserved != nullptr, in which case the worker threads are already gone.
+	void Shutdown(bool processTerminating);
+
+	Queue* CreateQueue(const char* name);
+	void Every(std::chrono::milliseconds interval, Job task);
+
+	template <class Fn>
+	void ForEachQueue(Fn&& fn) const
+	{
+		const auto count = queueCount.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; i++)
+			fn(*queues[i]);
+	}
+
+private:
+	struct Task
+	{
+		std::chrono::milliseconds interval;
+		Job run;
+		std::chrono::steady_clock::time_point due;
+	};
+
+	Worker() = default;
+
+	void Run(size_t thread);
+	bool RunQueues(size_t thread, size_t stride);
+	bool RunTasks(bool all);
+
+	std::mutex lock;  // creating queues and tasks
+	std::array<std::unique_ptr<Queue>, MaxQueues> queues;
+	std::atomic<size_t> queueCount = 0;
+	std::array<Task, MaxTasks> tasks;
+	std::atomic<size_t> taskCount = 0;
+
+	std::atomic<bool> started = false;
+	std::atomic<bool> stopping = false;
+	std::atomic<size_t> running = 0;
+	std::mutex wakeLock;
+	std::condition_variable wake;
+};
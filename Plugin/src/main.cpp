@@ -1,137 +1,142 @@
-#include "ffx_types.h"
+#include "ABCapture.h"
+#include "BiasPublisher.h"
+#include "Config.h"
+#include "ContextPool.h"
+#include "EffectUniforms.h"
+#include "EventLog.h"
+#include "FramePacing.h"
+#include "Fsr2Hooks.h"
+#include "GpuProfiler.h"
+#include "HookProfiler.h"
+#include "Hotkeys.h"
+#include "Metrics.h"
+#include "MetricsFile.h"
+#include "Overlay.h"
+#include "PassClassifier.h"
+#include "ResolutionDetector.h"
+#include "SamplerBias.h"
+#include "SamplerCache.h"
+#include "Worker.h"
+#include "ffx_fsr2.h"
 
 #define IMGUI_DISABLE_INCLUDE_IMCONFIG_H
 #include <imgui.h>
 #include <reshade/reshade.hpp>
 
-typedef int32_t FfxErrorCode;
-
-typedef struct FfxFsr2Interface
-{
-	void* fpCreateBackendContext;    ///< A callback function to create and initialize the backend context.
-	void* fpGetDeviceCapabilities;   ///< A callback function to query device capabilites.
-	void* fpDestroyBackendContext;   ///< A callback function to destroy the backendcontext. This also dereferences the device.
-	void* fpCreateResource;          ///< A callback function to create a resource.
-	void* fpRegisterResource;        ///< A callback function to register an external resource.
-	void* fpUnregisterResources;     ///< A callback function to unregister external resource.
-	void* fpGetResourceDescription;  ///< A callback function to retrieve a resource description.
-	void* fpDestroyResource;         ///< A callback function to destroy a resource.
-	void* fpCreatePipeline;          ///< A callback function to create a render or compute pipeline.
-	void* fpDestroyPipeline;         ///< A callback function to destroy a render or compute pipeline.
-	void* fpScheduleGpuJob;          ///< A callback function to schedule a render job.
-	void* fpExecuteGpuJobs;          ///< A callback function to execute all queued render jobs.
-
-	void* scratchBuffer;       ///< A preallocated buffer for memory utilized internally by the backend.
-	size_t scratchBufferSize;  ///< Size of the buffer pointed to by <c><i>scratchBuffer</i></c>.
-} FfxFsr2Interface;
-
-typedef struct FfxFsr2ContextDescription
-{
-	uint32_t flags;                 ///< A collection of <c><i>FfxFsr2InitializationFlagBits</i></c>.
-	FfxDimensions2D maxRenderSize;  ///< The maximum size that rendering will be performed at.
-	FfxDimensions2D displaySize;    ///< The size of the presentation resolution targeted by the upscaling process.
-	FfxFsr2Interface callbacks;     ///< A set of pointers to the backend implementation for FSR 2.0.
-	FfxDevice device;               ///< The abstracted device which is passed to some callback functions.
+HMODULE _hModule;
+bool _registeredAddon = false;
 
-	void* fpMessage;  ///< A pointer to a function that can recieve messages from the runtime.
-} FfxFsr2ContextDescription;
+Metrics::Histogram _scanTime{ "startup.scan_time", "ms", { 1, 2, 5, 10, 20, 50, 100, 200, 500 } };
 
-typedef struct FfxFsr2DispatchDescription
+std::filesystem::path GetPluginPath(std::wstring_view fileName)
 {
-	FfxCommandList commandList;              ///< The <c><i>FfxCommandList</i></c> to record FSR2 rendering commands into.
-	FfxResource color;                       ///< A <c><i>FfxResource</i></c> containing the color buffer for the current frame (at render resolution).
-	FfxResource depth;                       ///< A <c><i>FfxResource</i></c> containing 32bit depth values for the current frame (at render resolution).
-	FfxResource motionVectors;               ///< A <c><i>FfxResource</i></c> containing 2-dimensional motion vectors (at render resolution if <c><i>FFX_FSR2_ENABLE_DISPLAY_RESOLUTION_MOTION_VECTORS</i></c> is not set).
-	FfxResource exposure;                    ///< A optional <c><i>FfxResource</i></c> containing a 1x1 exposure value.
-	FfxResource reactive;                    ///< A optional <c><i>FfxResource</i></c> containing alpha value of reactive objects in the scene.
-	FfxResource transparencyAndComposition;  ///< A optional <c><i>FfxResource</i></c> containing alpha value of special objects in the scene.
-	FfxResource output;                      ///< A <c><i>FfxResource</i></c> containing the output color buffer for the current frame (at presentation resolution).
-	FfxFloatCoords2D jitterOffset;           ///< The subpixel jitter offset applied to the camera.
-	FfxFloatCoords2D motionVectorScale;      ///< The scale factor to apply to motion vectors.
-	FfxDimensions2D renderSize;              ///< The resolution that was used for rendering the input resources.
-	bool enableSharpening;                   ///< Enable an additional sharpening pass.
-	float sharpness;                         ///< The sharpness value between 0 and 1, where 0 is no additional sharpness and 1 is maximum additional sharpness.
-	float frameTimeDelta;                    ///< The time elapsed since the last frame (expressed in milliseconds).
-	float preExposure;                       ///< The pre exposure value (must be > 0.0f)
-	bool reset;                              ///< A boolean value which when set to true, indicates the camera has moved discontinuously.
-	float cameraNear;                        ///< The distance to the near plane of the camera.
-	float cameraFar;                         ///< The distance to the far plane of the camera.
-	float cameraFovAngleVertical;            ///< The camera angle field of view in the vertical direction (expressed in radians).
-	float viewSpaceToMetersFactor;           ///< The scale factor to convert view space units to meters
-
-	// EXPERIMENTAL reactive mask generation parameters
-	bool enableAutoReactive;      ///< A boolean value to indicate internal reactive autogeneration should be used
-	FfxResource colorOpaqueOnly;  ///< A <c><i>FfxResource</i></c> containing the opaque only color buffer for the current frame (at render resolution).
-	float autoTcThreshold;        ///< Cutoff value for TC
-	float autoTcScale;            ///< A value to scale the transparency and composition mask
-	float autoReactiveScale;      ///< A value to scale the reactive mask
-	float autoReactiveMax;        ///< A value to clamp the reactive mask
-} FfxFsr2DispatchDescription;
-
-static float* fMipBias = nullptr;
+	wchar_t path[MAX_PATH];
+	GetModuleFileNameW(_hModule, path, MAX_PATH);
+	return std::filesystem::path(path).parent_path() / fileName;
+}
 
-HMODULE _hModule;
-FfxDimensions2D _displaySize;
-bool _forceDisable = false;
-bool _registeredAddon = false;
+template <class Scan>
+uint8_t* MeasureScan(Scan&& scan)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = static_cast<uint8_t*>(scan());
+	_scanTime.Record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	return result;
+}
 
-void DrawMenu(reshade::api::effect_runtime*)
+void DrawMenu(reshade::api::effect_runtime* runtime)
 {
-	ImGui::Text(std::format("Current fMipBias {}", *fMipBias).c_str());
-	ImGui::Checkbox("Disable (for testing only)", &_forceDisable);
+	auto hooks = Fsr2Hooks::GetSingleton();
+	bool forceDisable = hooks->forceDisable.load(std::memory_order_relaxed);
+	Overlay::GetSingleton()->Draw(runtime, forceDisable);
+	hooks->forceDisable.store(forceDisable, std::memory_order_relaxed);
 }
 
-void AdjustBias(FfxFsr2DispatchDescription* dispatchParams)
+float OnBiasApplied(FfxDimensions2D renderSize, FfxDimensions2D displaySize, float bias, bool fromDispatch)
 {
-	float renderResolutionX = dispatchParams->renderSize.width;
-	float displayResolutionX = _displaySize.width;
+	auto samplerBias = SamplerBias::GetSingleton();
+	const bool samplerMode = samplerBias->enabled.load(std::memory_order_relaxed);
+	samplerBias->SetBias(bias);
+	Overlay::GetSingleton()->RecordBias(renderSize, displaySize, bias, fromDispatch);
+	FramePacing::GetSingleton()->MarkBias(bias);
+	EffectUniforms::GetSingleton()->Update(renderSize, displaySize, bias);
+	PassClassifier::GetSingleton()->SetResolutions(renderSize, displaySize);
+	ABCapture::GetSingleton()->RecordBias(renderSize, displaySize, bias);
+
+	// In sampler mode the setting is left neutral so the bias is not applied twice
+	return samplerMode ? 0.0f : bias;
+}
 
-	float bias = log2(renderResolutionX / displayResolutionX);
-	float clampedBias = std::clamp(bias, -10.0f, 0.0f);
+void OnDispatched(const FfxLayout::DispatchFields& fields)
+{
+	EffectUniforms::GetSingleton()->UpdateJitter(fields.jitterOffset);
+	ABCapture::GetSingleton()->RecordDispatch(fields);
+}
 
-	static bool erroredBefore = false;
-	if (bias != clampedBias && !erroredBefore) {
-		erroredBefore = true;
-		ERROR("Upscaling Fix BAD VALUE : renderResolutionX {} displayResolutionX {} bias {}", renderResolutionX, displayResolutionX, bias);
+void OnPresent(reshade::api::effect_runtime* runtime)
+{
+	Overlay::GetSingleton()->RecordPresent();
+
+	auto hooks = Fsr2Hooks::GetSingleton();
+	const auto actions = Hotkeys::GetSingleton()->Poll(runtime);
+	bool forceDisable = hooks->forceDisable.load(std::memory_order_relaxed);
+	if (actions & (1 << uint32_t(Hotkeys::Action::ToggleFix))) {
+		forceDisable = !forceDisable;
+		INFO("Fix {} by hot key", forceDisable ? "disabled" : "enabled");
+	}
+	if (actions & (1 << uint32_t(Hotkeys::Action::CycleBiasOffset))) {
+		const auto index = (hooks->biasOffsetIndex.load(std::memory_order_relaxed) + 1) % std::size(Fsr2Hooks::BiasOffsets);
+		hooks->biasOffsetIndex.store(index, std::memory_order_relaxed);
+		INFO("Bias offset set to {} by hot key", Fsr2Hooks::BiasOffsets[index]);
+	}
+	if (actions & (1 << uint32_t(Hotkeys::Action::ToggleCapture))) {
+		auto pacing = FramePacing::GetSingleton();
+		if (pacing->IsRecording())
+			pacing->StopRecording();
+		else
+			pacing->StartRecording(GetPluginPath(L"UpscalingFix.pacing.csv"));
 	}
 
-	*fMipBias = clampedBias;
+	// Before the pending bias is applied so a switch takes effect on the next frame
+	ABCapture::GetSingleton()->Advance(runtime, forceDisable);
+	hooks->forceDisable.store(forceDisable, std::memory_order_relaxed);
 
-	if (_forceDisable)
-		*fMipBias = 0;
-}
+	SamplerBias::GetSingleton()->ApplyPending();
+	PassClassifier::GetSingleton()->EndFrame();
+
+	auto detector = ResolutionDetector::GetSingleton();
+	detector->EndFrame(runtime);
 
-FfxErrorCode ffxFsr2ContextCreate_hook(void* context, FfxFsr2ContextDescription* contextDescription);
+	// FSR2 knows its own render size, detection only covers frames without an FSR2 dispatch
+	if (!hooks->CountPresent() || !Config::GetSingleton()->Get()->resolutionDetection)
+		return;
 
-decltype(&ffxFsr2ContextCreate_hook) ffxFsr2ContextCreate_original;
+	FfxDimensions2D renderSize, displaySize;
+	if (detector->GetDetected(renderSize, displaySize))
+		hooks->AdjustBias(renderSize, displaySize, false);
+}
 
-FfxErrorCode ffxFsr2ContextCreate_hook(void* context, FfxFsr2ContextDescription* contextDescription)
+void RegisterAddon()
 {
-	_displaySize = contextDescription->displaySize;
-	INFO("Initial displaySize {} {}", _displaySize.width, _displaySize.height);
+	if (_registeredAddon)
+		return;
 
-	if (!_registeredAddon) {
+	if (reshade::register_addon(_hModule)) {
 		_registeredAddon = true;
-
-		if (reshade::register_addon(_hModule)) {
-			INFO("Registered ReShade addon, adding menu");
-			reshade::register_overlay(nullptr, &DrawMenu);
-		} else {
-			INFO("Failed to register ReShade addon, not adding menu");
-		}
+		INFO("Registered ReShade addon, adding menu");
+		Overlay::GetSingleton()->SetOutputDirectory(GetPluginPath(L""));
+		reshade::register_overlay(nullptr, &DrawMenu);
+		reshade::register_event<reshade::addon_event::reshade_present>(&OnPresent);
+		GpuProfiler::GetSingleton()->Register();
+		ResolutionDetector::GetSingleton()->Register();
+		SamplerCache::GetSingleton()->Register();
+		SamplerBias::GetSingleton()->Register();
+		FramePacing::GetSingleton()->Register();
+		EffectUniforms::GetSingleton()->Register();
+		PassClassifier::GetSingleton()->Register();
+	} else {
+		INFO("Failed to register ReShade addon, not adding menu");
 	}
-
-	return (ffxFsr2ContextCreate_original)(context, contextDescription);
-}
-
-FfxErrorCode ffxFsr2ContextDispatch_hook(void* context, FfxFsr2DispatchDescription* dispatchParams);
-
-decltype(&ffxFsr2ContextDispatch_hook) ffxFsr2ContextDispatch_original;
-
-FfxErrorCode ffxFsr2ContextDispatch_hook(void* context, FfxFsr2DispatchDescription* dispatchParams)
-{
-	AdjustBias(dispatchParams);
-	return (ffxFsr2ContextDispatch_original)(context, dispatchParams);
 }
 
 void AddINISetting_fMipBias_hook(void* setting, char* name_section);
@@ -140,15 +145,19 @@ decltype(&AddINISetting_fMipBias_hook) AddINISetting_fMipBias_original;
 
 void AddINISetting_fMipBias_hook(void* setting, char* name_section)
 {
-	fMipBias = reinterpret_cast<float*>(AsAddress(setting) + 8);
+	const auto fMipBias = reinterpret_cast<float*>(AsAddress(setting) + 8);
 	INFO("Found fMipBias at {:X}", AsAddress(fMipBias) - dku::Hook::Module::get().base() + 0x140000000);
+	BiasPublisher::GetSingleton()->SetTarget(fMipBias);
+
+	// Without FSR2 the context create hook never runs, resolution detection needs the addon registered regardless
+	RegisterAddon();
 	return (AddINISetting_fMipBias_original)(setting, name_section);
 }
 
 extern "C" DLLEXPORT const char* NAME = "Upscaling Fix for Starfield";
 extern "C" DLLEXPORT const char* DESCRIPTION = "";
 
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReason, LPVOID)
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReason, LPVOID lpReserved)
 {
 	if (dwReason == DLL_PROCESS_ATTACH) {
 #ifndef NDEBUG
@@ -162,10 +171,40 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReason, LPVOID)
 
 		INFO("{} v{} loaded", Plugin::NAME, Plugin::Version);
 
+		Worker::GetSingleton()->Start();
+		EventLog::GetSingleton()->Start(GetPluginPath(L"UpscalingFix.events.bin"));
+		MetricsFile::GetSingleton()->Start(GetPluginPath(L"UpscalingFix.metrics.json"));
+		HookProfiler::GetSingleton()->Start();
+
+		// The overlay can still flip these afterwards, until the next reload
+		auto config = Config::GetSingleton();
+		config->Subscribe([](const Config::Settings& settings) {
+			SamplerBias::GetSingleton()->enabled = settings.samplerBias;
+			SamplerBias::GetSingleton()->geometryOnly = settings.geometryPassesOnly;
+			HookProfiler::GetSingleton()->enabled = settings.hookTelemetry;
+			EventLog::GetSingleton()->binary = settings.binaryEventLog;
+			MetricsFile::GetSingleton()->enabled = settings.metricsFile;
+		});
+		config->Start(GetPluginPath(L"UpscalingFix.toml"));
+
 		dku::Hook::Trampoline::AllocTrampoline(42);
 
+		Fsr2Hooks::Listeners listeners;
+		listeners.contextCreated = &RegisterAddon;
+		listeners.biasApplied = &OnBiasApplied;
+		listeners.dispatched = &OnDispatched;
+		listeners.reset = [] { FramePacing::GetSingleton()->MarkReset(); };
+		listeners.beginDispatch = [] { GpuProfiler::GetSingleton()->BeginDispatch(); };
+		listeners.endDispatch = [] { GpuProfiler::GetSingleton()->EndDispatch(); };
+		auto hooks = Fsr2Hooks::GetSingleton();
+		hooks->SetListeners(listeners);
+
+		BiasPublisher::GetSingleton()->Subscribe([](float bias, uint64_t version) {
+			EventLog::GetSingleton()->Post<EventLog::Event::BiasChanged>(bias, version);
+		});
+
 		{
-			const auto scan = static_cast<uint8_t*>(dku::Hook::Assembly::search_pattern<"E8 ?? ?? ?? ?? 48 8D 0D ?? ?? ?? ?? 48 83 C4 28 E9 ?? ?? ?? ?? CC CC CC CC CC 48 83 EC 18">());
+			const auto scan = MeasureScan([] { return dku::Hook::Assembly::search_pattern<"E8 ?? ?? ?? ?? 48 8D 0D ?? ?? ?? ?? 48 83 C4 28 E9 ?? ?? ?? ?? CC CC CC CC CC 48 83 EC 18">(); });
 			if (!scan) {
 				ERROR("Failed to find AddINISetting_fMipBias_hook!")
 			}
@@ -174,23 +213,46 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReason, LPVOID)
 		}
 			
 		{
-			const auto scan = static_cast<uint8_t*>(dku::Hook::Assembly::search_pattern<"48 8B 49 10 E8 ?? ?? ?? ?? 48 81 C4 ?? ?? ?? ??">());
+			const auto scan = MeasureScan([] { return dku::Hook::Assembly::search_pattern<"48 8B 49 10 E8 ?? ?? ?? ?? 48 81 C4 ?? ?? ?? ??">(); });
 			if (!scan) {
 				ERROR("Failed to find ffxFsr2ContextCreate!")
 			}
-			ffxFsr2ContextCreate_original = dku::Hook::write_call<5>(AsAddress(scan) + 0x4, ffxFsr2ContextCreate_hook);
+			hooks->SetCreateOriginal(dku::Hook::write_call<5>(AsAddress(scan) + 0x4, &Fsr2Hooks::ContextCreate_hook));
 			INFO("Found ffxFsr2ContextCreate at {:X}", AsAddress(scan) + 0x4 - dku::Hook::Module::get().base() + 0x140000000);
 		}
 					
 		{
-			const auto scan = static_cast<uint8_t*>(dku::Hook::Assembly::search_pattern<"89 9D 20 07 00 00 88 85 38 07 00 00 E8 ?? ?? ?? ??">());
+			// The call site stores renderSize.width and reset into the description right before the call. One exact
+			// pattern per known SDK layout, the displacements differ by the distance between the two fields and
+			// the pattern that matches tells which layout the game was built with.
+			static_assert(FfxLayout::FromResetDistance(0x738 - 0x720) == FfxLayout::Version::Fsr22);
+			static_assert(FfxLayout::FromResetDistance(0x734 - 0x720) == FfxLayout::Version::Fsr20);
+
+			auto version = FfxLayout::Version::Fsr22;
+			auto scan = MeasureScan([] { return dku::Hook::Assembly::search_pattern<"89 9D 20 07 00 00 88 85 38 07 00 00 E8 ?? ?? ?? ??">(); });
+			if (!scan) {
+				version = FfxLayout::Version::Fsr20;
+				scan = MeasureScan([] { return dku::Hook::Assembly::search_pattern<"89 9D 20 07 00 00 88 85 34 07 00 00 E8 ?? ?? ?? ??">(); });
+			}
 			if (!scan) {
 				ERROR("Failed to find ffxFsr2ContextDispatch!")
+				return TRUE;
 			}
-			ffxFsr2ContextDispatch_original = dku::Hook::write_call<5>(AsAddress(scan) + 0xC, ffxFsr2ContextDispatch_hook);
+
+			hooks->SetDispatchLayout(version);
+			INFO("Using FSR {} dispatch layout", version == FfxLayout::Version::Fsr20 ? "2.0" : "2.1+");
+
+			hooks->SetDispatchOriginal(dku::Hook::write_call<5>(AsAddress(scan) + 0xC, &Fsr2Hooks::ContextDispatch_hook));
 			INFO("Found ffxFsr2ContextDispatch at {:X}", AsAddress(scan) + 0xC - dku::Hook::Module::get().base() + 0x140000000);
 		}
 
+	} else if (dwReason == DLL_PROCESS_DETACH) {
+		// Writes out queued captures, log records and pacing rows
+		Worker::GetSingleton()->Shutdown(lpReserved != nullptr);
+
+		// Unloaded while the game keeps running, pooled contexts would keep its device alive for good
+		if (!lpReserved)
+			ContextPool::GetSingleton()->ReleaseAll();
 	}
 	return TRUE;
 }
\ No newline at end of file
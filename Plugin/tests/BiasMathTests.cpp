@@ -0,0 +1,83 @@
+#include "BiasMath.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+TEST(BiasMath, NativeResolutionIsNeutral)
+{
+	const auto result = BiasMath::Compute({ 3840, 2160 }, { 3840, 2160 }, {}, 0.0f);
+	EXPECT_TRUE(result.valid);
+	EXPECT_FALSE(result.outOfRange);
+	EXPECT_EQ(result.ratioBias, 0.0f);
+	EXPECT_EQ(result.bias, 0.0f);
+}
+
+TEST(BiasMath, FollowsRenderScale)
+{
+	const auto result = BiasMath::Compute({ 1920, 1080 }, { 3840, 2160 }, {}, 0.0f);
+	EXPECT_TRUE(result.valid);
+	EXPECT_EQ(result.ratioBias, -1.0f);
+	EXPECT_EQ(result.bias, -1.0f);
+
+	const auto quality = BiasMath::Compute({ 2560, 1440 }, { 3840, 2160 }, {}, 0.0f);
+	EXPECT_NEAR(quality.bias, std::log2(2560.0 / 3840.0), BiasMath::Log2Error);
+}
+
+TEST(BiasMath, AppliesFormulaAndClamps)
+{
+	const BiasFormula formula{ 2.0f, -0.5f, -3.0f, 0.0f };
+	EXPECT_FLOAT_EQ(BiasMath::Compute({ 1920, 1080 }, { 3840, 2160 }, formula, 0.0f).bias, -2.5f);
+	EXPECT_FLOAT_EQ(BiasMath::Compute({ 1920, 1080 }, { 3840, 2160 }, formula, -0.25f).bias, -2.75f);
+	EXPECT_FLOAT_EQ(BiasMath::Compute({ 960, 540 }, { 3840, 2160 }, formula, 0.0f).bias, -3.0f);
+	EXPECT_FLOAT_EQ(BiasMath::Compute({ 3840, 2160 }, { 3840, 2160 }, formula, 1.0f).bias, 0.0f);
+}
+
+TEST(BiasMath, FlagsImpossibleRatios)
+{
+	const auto upscaled = BiasMath::Compute({ 7680, 4320 }, { 3840, 2160 }, {}, 0.0f);
+	EXPECT_TRUE(upscaled.valid);
+	EXPECT_TRUE(upscaled.outOfRange);
+	EXPECT_EQ(upscaled.bias, 0.0f);
+
+	const auto zero = BiasMath::Compute({ 0, 0 }, { 3840, 2160 }, {}, 0.0f);
+	EXPECT_FALSE(zero.valid);
+	EXPECT_TRUE(zero.outOfRange);
+
+	EXPECT_FALSE(BiasMath::Compute({ 1920, 1080 }, { 0, 0 }, {}, 0.0f).valid);
+}
+
+TEST(BiasMath, RejectsNonFiniteFormula)
+{
+	BiasFormula formula;
+	formula.offset = std::numeric_limits<float>::quiet_NaN();
+	EXPECT_FALSE(BiasMath::Compute({ 1920, 1080 }, { 3840, 2160 }, formula, 0.0f).valid);
+}
+
+TEST(BiasMath, FastLog2SpecialValues)
+{
+	EXPECT_EQ(BiasMath::FastLog2(1.0f), 0.0f);
+	EXPECT_EQ(BiasMath::FastLog2(0.25f), -2.0f);
+	EXPECT_EQ(BiasMath::FastLog2(0.0f), -BiasMath::Log2Limit);
+	EXPECT_EQ(BiasMath::FastLog2(-1.0f), -BiasMath::Log2Limit);
+	EXPECT_EQ(BiasMath::FastLog2(std::numeric_limits<float>::denorm_min()), -BiasMath::Log2Limit);
+	EXPECT_EQ(BiasMath::FastLog2(std::numeric_limits<float>::quiet_NaN()), -BiasMath::Log2Limit);
+	EXPECT_EQ(BiasMath::FastLog2(std::numeric_limits<float>::infinity()), BiasMath::Log2Limit);
+}
+
+TEST(BiasMath, FastLog2WithinErrorForEveryRatio)
+{
+	// Every float in the documented domain, about 168 million
+	double worst = 0.0;
+	float worstAt = 0.0f;
+	for (uint32_t bits = std::bit_cast<uint32_t>(0x1p-10f); bits <= std::bit_cast<uint32_t>(0x1p10f); bits++) {
+		const float x = std::bit_cast<float>(bits);
+		const double error = std::abs(double(BiasMath::FastLog2(x)) - std::log2(double(x)));
+		if (error > worst) {
+			worst = error;
+			worstAt = x;
+		}
+	}
+	EXPECT_LE(worst, BiasMath::Log2Error) << "at " << worstAt;
+}
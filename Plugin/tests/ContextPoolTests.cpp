@@ -0,0 +1,161 @@
+#include "ContextPool.h"
+#include "FfxUtil.h"
+#include "ffx_fsr2_mock.h"
+
+#include <gtest/gtest.h>
+
+// ContextPool is a process wide singleton, every test uses a device of its own so pooled entries of
+// other tests never match, and releases it before its harnesses, which hold the pooled backends, go away.
+namespace
+{
+	FfxDevice MakeDevice(uintptr_t id)
+	{
+		return reinterpret_cast<FfxDevice>(id << 4);
+	}
+
+	Mock::BackendContext* GetBackend(FfxFsr2Context* context)
+	{
+		return Mock::GetBackendContext(FfxUtil::GetInterface(context));
+	}
+
+	// Counts what reaches the mock backend through the pool
+	struct Counts
+	{
+		size_t resourcesCreated = 0;
+		size_t resourcesDestroyed = 0;
+		size_t backendsDestroyed = 0;
+		size_t failResource = 0;  // 1 based, 0 never fails
+	} counts;
+
+	FfxFsr2Interface mock;
+
+	void Instrument(FfxFsr2Interface& callbacks)
+	{
+		mock = callbacks;
+		counts = {};
+		callbacks.fpCreateResource = [](FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* description, FfxResourceInternal* outResource) -> FfxErrorCode {
+			if (counts.failResource && counts.resourcesCreated + 1 == counts.failResource)
+				return FFX_ERROR_OUT_OF_MEMORY;
+			counts.resourcesCreated++;
+			return mock.fpCreateResource(backendInterface, description, outResource);
+		};
+		callbacks.fpDestroyResource = [](FfxFsr2Interface* backendInterface, FfxResourceInternal resource) -> FfxErrorCode {
+			counts.resourcesDestroyed++;
+			return mock.fpDestroyResource(backendInterface, resource);
+		};
+		callbacks.fpDestroyBackendContext = [](FfxFsr2Interface* backendInterface) -> FfxErrorCode {
+			counts.backendsDestroyed++;
+			return mock.fpDestroyBackendContext(backendInterface);
+		};
+	}
+}
+
+TEST(ContextPool, ReusesDestroyedContexts)
+{
+	auto pool = ContextPool::GetSingleton();
+
+	Mock::Harness first;
+	auto description = first.MakeContextDescription({ 1920, 1080 }, { 3840, 2160 }, MakeDevice(1));
+	ASSERT_EQ(pool->Create(first.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_OK);
+	const auto backend = GetBackend(first.context.get());
+	ASSERT_NE(backend, nullptr);
+	EXPECT_FALSE(pool->ConsumeReset(first.context.get()));
+
+	auto dispatch = Mock::MakeDispatchDescription({ 1920, 1080 });
+	ASSERT_EQ(ffxFsr2ContextDispatchMock(first.context.get(), &dispatch), FFX_OK);
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(first.context.get()), FFX_OK);
+
+	// Destroy only returned it, the backend and its resources are still there
+	ASSERT_EQ(backend->resources.size(), 13u);
+	EXPECT_TRUE(backend->resources.front().alive);
+
+	Mock::Harness second;
+	auto again = second.MakeContextDescription({ 1920, 1080 }, { 3840, 2160 }, MakeDevice(1));
+	ASSERT_EQ(pool->Create(second.context.get(), &again, &ffxFsr2ContextCreateMock), FFX_OK);
+	EXPECT_EQ(GetBackend(second.context.get()), backend);
+
+	// The reused history is stale, the first dispatch has to reset it
+	EXPECT_TRUE(pool->ConsumeReset(second.context.get()));
+	EXPECT_FALSE(pool->ConsumeReset(second.context.get()));
+
+	ffxFsr2ContextDestroyMock(second.context.get());
+	pool->ReleaseDevice(MakeDevice(1));
+}
+
+TEST(ContextPool, KeysOnDevice)
+{
+	auto pool = ContextPool::GetSingleton();
+
+	Mock::Harness first;
+	auto description = first.MakeContextDescription({ 1280, 720 }, { 2560, 1440 }, MakeDevice(2));
+	ASSERT_EQ(pool->Create(first.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_OK);
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(first.context.get()), FFX_OK);
+
+	// Same sizes and flags on another device must not get the first device's resources
+	Mock::Harness second;
+	auto other = second.MakeContextDescription({ 1280, 720 }, { 2560, 1440 }, MakeDevice(3));
+	ASSERT_EQ(pool->Create(second.context.get(), &other, &ffxFsr2ContextCreateMock), FFX_OK);
+	ASSERT_NE(GetBackend(second.context.get()), nullptr);
+	EXPECT_EQ(GetBackend(second.context.get())->device, MakeDevice(3));
+	EXPECT_FALSE(pool->ConsumeReset(second.context.get()));
+
+	ffxFsr2ContextDestroyMock(second.context.get());
+	pool->ReleaseDevice(MakeDevice(2));
+	pool->ReleaseDevice(MakeDevice(3));
+}
+
+TEST(ContextPool, ReleasesEverythingWhenCreateFails)
+{
+	auto pool = ContextPool::GetSingleton();
+	const auto pooledBytes = pool->GetPooledBytes();
+
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1600, 900 }, { 3200, 1800 }, MakeDevice(4));
+	Instrument(description.callbacks);
+	counts.failResource = 5;
+
+	EXPECT_EQ(pool->Create(harness.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_ERROR_OUT_OF_MEMORY);
+	EXPECT_EQ(counts.resourcesCreated, 4u);
+	EXPECT_EQ(counts.resourcesDestroyed, 4u);
+	EXPECT_EQ(counts.backendsDestroyed, 1u);
+	EXPECT_EQ(pool->GetPooledBytes(), pooledBytes);
+
+	// Nothing of the failed attempt is pooled, a retry creates from scratch
+	counts = {};
+	ASSERT_EQ(pool->Create(harness.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_OK);
+	EXPECT_EQ(counts.resourcesCreated, 13u);
+	EXPECT_FALSE(pool->ConsumeReset(harness.context.get()));
+
+	ffxFsr2ContextDestroyMock(harness.context.get());
+	pool->ReleaseDevice(MakeDevice(4));
+}
+
+TEST(ContextPool, ReleasesIdleContextsOfAReplacedDevice)
+{
+	auto pool = ContextPool::GetSingleton();
+
+	Mock::Harness first;
+	auto description = first.MakeContextDescription({ 1280, 720 }, { 2560, 1440 }, MakeDevice(5));
+	ASSERT_EQ(pool->Create(first.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_OK);
+	auto dispatch = Mock::MakeDispatchDescription({ 1280, 720 });
+	ASSERT_EQ(ffxFsr2ContextDispatchMock(first.context.get(), &dispatch), FFX_OK);
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(first.context.get()), FFX_OK);
+
+	// The idle entry still references the device, the game releasing it does not destroy it
+	EXPECT_EQ(Mock::GetDeviceReferences(MakeDevice(5)), 1u);
+
+	// The game destroyed its device and created a new one, its first context lets the old device go
+	Mock::Harness second;
+	auto replaced = second.MakeContextDescription({ 1280, 720 }, { 2560, 1440 }, MakeDevice(6));
+	ASSERT_EQ(pool->Create(second.context.get(), &replaced, &ffxFsr2ContextCreateMock), FFX_OK);
+	EXPECT_EQ(Mock::GetDeviceReferences(MakeDevice(5)), 0u);
+	EXPECT_EQ(Mock::GetDeviceReferences(MakeDevice(6)), 1u);
+
+	// A context the game still runs is kept, once returned it goes on unload
+	pool->ReleaseAll();
+	EXPECT_EQ(Mock::GetDeviceReferences(MakeDevice(6)), 1u);
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(second.context.get()), FFX_OK);
+	pool->ReleaseAll();
+	EXPECT_EQ(Mock::GetDeviceReferences(MakeDevice(6)), 0u);
+	EXPECT_EQ(pool->GetPooledBytes(), 0u);
+}
@@ -0,0 +1,52 @@
+#include "EventFormat.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	std::string FormatInt(std::string_view format, int64_t value)
+	{
+		EventFormat::Arg arg;
+		arg.i = value;
+		return EventFormat::Format(format, "i", &arg);
+	}
+
+	std::string FormatDouble(std::string_view format, double value)
+	{
+		EventFormat::Arg arg;
+		arg.f = value;
+		return EventFormat::Format(format, "f", &arg);
+	}
+}
+
+TEST(EventFormat, ExpandsPlaceholders)
+{
+	EventFormat::Arg args[2];
+	args[0].i = 255;
+	args[1].f = 0.5;
+	EXPECT_EQ(EventFormat::Format("a {} b {:.2f} {{c}}", "if", args), "a 255 b 0.50 {c}");
+	EXPECT_EQ(FormatInt("{:X}", 255), "FF");
+	EXPECT_EQ(FormatInt("{:08x}", 255), "000000ff");
+	EXPECT_EQ(FormatInt("{:+d}", 5), "+5");
+	EXPECT_EQ(FormatDouble("{}", 0.25), "0.25");
+	EXPECT_EQ(FormatDouble("{:-8.3}", 0.25), "0.25    ");
+}
+
+TEST(EventFormat, RejectsSpecsNotValidForTheType)
+{
+	// Used to reach snprintf as is, %s with an integer crashed
+	EXPECT_EQ(FormatInt("{:s}", 1), "{:s}");
+	EXPECT_EQ(FormatInt("{:n}", 1), "{:n}");
+	EXPECT_EQ(FormatInt("{:f}", 1), "{:f}");
+	EXPECT_EQ(FormatDouble("{:x}", 1.0), "{:x}");
+	EXPECT_EQ(FormatDouble("{:*.2f}", 1.0), "{:*.2f}");
+	EXPECT_EQ(FormatDouble("{:%s%s}", 1.0), "{:%s%s}");
+	EXPECT_EQ(FormatDouble("{:lf}", 1.0), "{:lf}");
+	EXPECT_EQ(FormatInt("{:999d}", 1), "{:999d}");
+	EXPECT_EQ(FormatInt("{:.123d}", 1), "{:.123d}");
+
+	EventFormat::Arg args[2];
+	args[0].i = 1;
+	args[1].i = 2;
+	EXPECT_EQ(EventFormat::Format("{} {}", "?i", args), "{} 2");
+}
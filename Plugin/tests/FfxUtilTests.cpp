@@ -0,0 +1,95 @@
+#include "FfxUtil.h"
+
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <limits>
+
+namespace
+{
+	FfxLayout::DispatchFields ValidDispatch()
+	{
+		FfxLayout::DispatchFields fields{};
+		fields.renderSize = { 1920, 1080 };
+		fields.jitterOffset = { 0.25f, -0.25f };
+		fields.frameTimeDelta = 16.6f;
+		fields.sharpness = 0.5f;
+		return fields;
+	}
+}
+
+TEST(FfxUtil, AcceptsValidDispatch)
+{
+	EXPECT_EQ(FfxUtil::ValidateDispatch(ValidDispatch(), { 3840, 2160 }), FfxUtil::DispatchError::None);
+	EXPECT_EQ(FfxUtil::ValidateDispatch(ValidDispatch(), { 0, 0 }), FfxUtil::DispatchError::None);
+}
+
+TEST(FfxUtil, RejectsBadRenderSize)
+{
+	auto fields = ValidDispatch();
+	fields.renderSize = { 0, 1080 };
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::RenderSize);
+
+	fields.renderSize = { FfxUtil::MaxDimension + 1, 1080 };
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 0, 0 }), FfxUtil::DispatchError::RenderSize);
+
+	fields.renderSize = { 3840, 2160 };
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 1920, 1080 }), FfxUtil::DispatchError::RenderSize);
+}
+
+TEST(FfxUtil, RejectsBadFloats)
+{
+	auto fields = ValidDispatch();
+	fields.jitterOffset.x = std::numeric_limits<float>::quiet_NaN();
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::Jitter);
+
+	fields = ValidDispatch();
+	fields.jitterOffset.y = FLT_MIN / 2.0f;
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::Jitter);
+
+	fields = ValidDispatch();
+	fields.jitterOffset.y = 1.5f;
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::Jitter);
+
+	fields = ValidDispatch();
+	fields.frameTimeDelta = -1.0f;
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::FrameTime);
+
+	fields = ValidDispatch();
+	fields.sharpness = std::numeric_limits<float>::infinity();
+	EXPECT_EQ(FfxUtil::ValidateDispatch(fields, { 3840, 2160 }), FfxUtil::DispatchError::Sharpness);
+}
+
+TEST(FfxUtil, ValidatesContexts)
+{
+	FfxFsr2ContextDescription description{};
+	description.maxRenderSize = { 3840, 2160 };
+	description.displaySize = { 3840, 2160 };
+	EXPECT_TRUE(FfxUtil::IsValidContext(description));
+
+	description.displaySize = { 0, 2160 };
+	EXPECT_FALSE(FfxUtil::IsValidContext(description));
+
+	description.displaySize = { 3840, FfxUtil::MaxDimension + 1 };
+	EXPECT_FALSE(FfxUtil::IsValidContext(description));
+}
+
+TEST(FfxUtil, EstimatesMipChains)
+{
+	FfxResourceDescription description{};
+	description.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+	description.format = FFX_SURFACE_FORMAT_R32_FLOAT;
+	description.width = 4;
+	description.height = 4;
+	description.depth = 1;
+	description.mipCount = 1;
+	EXPECT_EQ(FfxUtil::EstimateResourceSize(description), 64u);
+
+	// 0 is a full chain: 4x4, 2x2, 1x1
+	description.mipCount = 0;
+	EXPECT_EQ(FfxUtil::EstimateResourceSize(description), (16u + 4u + 1u) * 4u);
+
+	description.type = FFX_RESOURCE_TYPE_BUFFER;
+	description.width = 1000;
+	EXPECT_EQ(FfxUtil::EstimateResourceSize(description), 1000u);
+}
@@ -0,0 +1,38 @@
+#include "InplaceFunction.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+TEST(InplaceFunction, CallsAndMovesItsCapture)
+{
+	auto counter = std::make_shared<int>(0);
+	InplaceFunction<32> function([counter] { (*counter)++; });
+	ASSERT_TRUE(function);
+	function();
+	EXPECT_EQ(*counter, 1);
+	EXPECT_EQ(counter.use_count(), 2);
+
+	// The capture moves along, leaving the source empty
+	InplaceFunction<32> moved(std::move(function));
+	EXPECT_FALSE(function);
+	EXPECT_EQ(counter.use_count(), 2);
+	moved();
+	EXPECT_EQ(*counter, 2);
+
+	function = std::move(moved);
+	EXPECT_FALSE(moved);
+	function = nullptr;
+	EXPECT_FALSE(function);
+	EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(InplaceFunction, HoldsMoveOnlyCaptures)
+{
+	int value = 0;
+	InplaceFunction<32> function([pointer = std::make_unique<int>(7), &value] { value = *pointer; });
+	InplaceFunction<32> other;
+	other = std::move(function);
+	other();
+	EXPECT_EQ(value, 7);
+}
@@ -0,0 +1,78 @@
+#include "Metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	Metrics::Counter testCounter{ "test.counter" };
+	Metrics::Gauge testGauge{ "test.gauge", "px" };
+	Metrics::Histogram testHistogram{ "test.histogram", "ms", { 1, 10, 100 } };
+
+	Metrics::Counter concurrentCounter{ "concurrent.counter" };
+	Metrics::Histogram concurrentHistogram{ "concurrent.histogram", "", { 0.5 } };
+}
+
+TEST(Metrics, RegistersDefinitions)
+{
+	size_t found = 0;
+	Metrics::ForEach([&](const Metrics::Metric& metric) {
+		if (std::strncmp(metric.GetName(), "test.", 5) == 0)
+			found++;
+	});
+	EXPECT_EQ(found, 3u);
+	EXPECT_STREQ(testGauge.GetUnit(), "px");
+}
+
+TEST(Metrics, CountsAndBuckets)
+{
+	const auto before = testCounter.Get();
+	testCounter.Add();
+	testCounter.Add(4);
+	EXPECT_EQ(testCounter.Get(), before + 5);
+
+	testGauge.Set(1920.0);
+	EXPECT_EQ(testGauge.Get(), 1920.0);
+
+	ASSERT_EQ(testHistogram.GetBuckets(), 4u);
+	for (double sample : { 0.5, 1.0, 5.0, 50.0, 500.0, 5000.0 })
+		testHistogram.Record(sample);
+
+	const auto snapshot = testHistogram.Get();
+	EXPECT_EQ(snapshot.count, 6u);
+	EXPECT_EQ(snapshot.counts[0], 2u);
+	EXPECT_EQ(snapshot.counts[1], 1u);
+	EXPECT_EQ(snapshot.counts[2], 1u);
+	EXPECT_EQ(snapshot.counts[3], 2u);
+	EXPECT_DOUBLE_EQ(snapshot.Mean(), 5556.5 / 6.0);
+}
+
+TEST(Metrics, ConcurrentUpdatesAddUp)
+{
+	// More threads than shards, so some of them share one
+	constexpr size_t Threads = 12;
+	constexpr size_t Iterations = 100000;
+	static_assert(Threads > Metrics::Shards);
+
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < Threads; thread++) {
+		threads.emplace_back([&, thread] {
+			for (size_t i = 0; i < Iterations; i++) {
+				concurrentCounter.Add();
+				concurrentHistogram.Record(double(thread & 1));
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	EXPECT_EQ(concurrentCounter.Get(), Threads * Iterations);
+	const auto snapshot = concurrentHistogram.Get();
+	EXPECT_EQ(snapshot.count, Threads * Iterations);
+	EXPECT_EQ(snapshot.counts[0], Threads / 2 * Iterations);
+	EXPECT_EQ(snapshot.counts[1], Threads / 2 * Iterations);
+	EXPECT_DOUBLE_EQ(snapshot.sum, double(Threads / 2 * Iterations));
+}
@@ -0,0 +1,92 @@
+#include "FfxUtil.h"
+#include "ffx_fsr2_mock.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	constexpr size_t InternalResources = 13;
+	constexpr size_t HistoryResources = 7;
+	constexpr size_t ComputePasses = 5;  // without sharpening
+
+	const auto Device = reinterpret_cast<FfxDevice>(uintptr_t(0x1000));
+}
+
+TEST(Mock, CreatesAndDestroysContext)
+{
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1920, 1080 }, { 3840, 2160 }, Device);
+	ASSERT_EQ(ffxFsr2ContextCreateMock(harness.context.get(), &description), FFX_OK);
+
+	// The runtime works through the copy in the context memory, where FfxUtil expects the interface
+	auto backendInterface = FfxUtil::GetInterface(harness.context.get());
+	auto backend = Mock::GetBackendContext(backendInterface);
+	ASSERT_NE(backend, nullptr);
+	EXPECT_EQ(backend->device, Device);
+	EXPECT_EQ(backend->resources.size(), InternalResources);
+	EXPECT_EQ(backend->pipelines.size(), size_t(FFX_FSR2_PASS_COUNT));
+	EXPECT_GT(backend->hostBytes, size_t(3840) * 2160 * 8);
+
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(harness.context.get()), FFX_OK);
+	EXPECT_EQ(Mock::GetBackendContext(backendInterface), nullptr);
+}
+
+TEST(Mock, SizesResourcesLikeTheCore)
+{
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1280, 720 }, { 2560, 1440 }, Device);
+	ASSERT_EQ(ffxFsr2ContextCreateMock(harness.context.get(), &description), FFX_OK);
+
+	auto backend = Mock::GetBackendContext(FfxUtil::GetInterface(harness.context.get()));
+	ASSERT_NE(backend, nullptr);
+	for (const auto& resource : backend->resources) {
+		const auto& desc = resource.description;
+		EXPECT_EQ(resource.memory.size(), size_t(desc.width) * desc.height * FfxUtil::GetFormatSize(desc.format));
+	}
+
+	ffxFsr2ContextDestroyMock(harness.context.get());
+}
+
+TEST(Mock, ClearsHistoryOnFirstDispatchAndReset)
+{
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1920, 1080 }, { 3840, 2160 }, Device);
+	ASSERT_EQ(ffxFsr2ContextCreateMock(harness.context.get(), &description), FFX_OK);
+	auto backend = Mock::GetBackendContext(FfxUtil::GetInterface(harness.context.get()));
+	ASSERT_NE(backend, nullptr);
+
+	auto dispatch = Mock::MakeDispatchDescription({ 1920, 1080 });
+	ASSERT_EQ(ffxFsr2ContextDispatchMock(harness.context.get(), &dispatch), FFX_OK);
+	EXPECT_EQ(backend->executed.size(), HistoryResources + ComputePasses);
+
+	ASSERT_EQ(ffxFsr2ContextDispatchMock(harness.context.get(), &dispatch), FFX_OK);
+	EXPECT_EQ(backend->executed.size(), HistoryResources + ComputePasses * 2);
+
+	dispatch.reset = true;
+	ASSERT_EQ(ffxFsr2ContextDispatchMock(harness.context.get(), &dispatch), FFX_OK);
+	EXPECT_EQ(backend->executed.size(), HistoryResources * 2 + ComputePasses * 3);
+	EXPECT_EQ(backend->submissions, 3u);
+
+	// Inputs are registered per dispatch and dropped again afterwards
+	EXPECT_EQ(backend->resources.size(), InternalResources);
+
+	ffxFsr2ContextDestroyMock(harness.context.get());
+}
+
+TEST(Mock, ReleasesOnFailedCreate)
+{
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1920, 1080 }, { 3840, 2160 }, Device);
+
+	// Fails the third resource, everything created before it has to be destroyed again
+	static int created;
+	created = 0;
+	static FfxFsr2CreateResourceFunc original;
+	original = description.callbacks.fpCreateResource;
+	description.callbacks.fpCreateResource = [](FfxFsr2Interface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxResourceInternal* outResource) -> FfxErrorCode {
+		return ++created == 3 ? FFX_ERROR_OUT_OF_MEMORY : original(backendInterface, createResourceDescription, outResource);
+	};
+
+	EXPECT_EQ(ffxFsr2ContextCreateMock(harness.context.get(), &description), FFX_ERROR_OUT_OF_MEMORY);
+	EXPECT_EQ(Mock::GetBackendContext(FfxUtil::GetInterface(harness.context.get())), nullptr);
+}
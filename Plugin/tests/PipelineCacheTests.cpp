@@ -0,0 +1,117 @@
+#include "ContextPool.h"
+#include "PipelineCache.h"
+#include "ffx_fsr2_mock.h"
+
+#include <gtest/gtest.h>
+
+// PipelineCache is a process wide singleton shared with the ContextPool tests, so devices here are unique
+// and counts are compared relative to the start of each test.
+namespace
+{
+	FfxDevice MakeDevice(uintptr_t id)
+	{
+		return reinterpret_cast<FfxDevice>(id << 4);
+	}
+
+	size_t created = 0;
+	size_t destroyed = 0;
+
+	FfxErrorCode CountingCreate(FfxFsr2Interface*, FfxFsr2Pass, const FfxPipelineDescription*, FfxPipelineState* outPipeline)
+	{
+		*outPipeline = {};
+		outPipeline->pipeline = reinterpret_cast<void*>(++created);
+		return FFX_OK;
+	}
+
+	FfxErrorCode CountingDestroy(FfxFsr2Interface*, FfxPipelineState* pipeline)
+	{
+		destroyed++;
+		pipeline->pipeline = nullptr;
+		return FFX_OK;
+	}
+
+	FfxPipelineDescription MakeDescription(FfxFilterType* samplers, uint32_t* sizes)
+	{
+		FfxPipelineDescription description{};
+		description.contextFlags = 1;
+		description.samplers = samplers;
+		description.samplerCount = 2;
+		description.rootConstantBufferSizes = sizes;
+		description.rootConstantBufferCount = 1;
+		return description;
+	}
+}
+
+TEST(PipelineCache, SharesPipelinesPerDevice)
+{
+	auto cache = PipelineCache::GetSingleton();
+	FfxFilterType samplers[] = { FFX_FILTER_TYPE_POINT, FFX_FILTER_TYPE_LINEAR };
+	uint32_t sizes[] = { 54 };
+	auto description = MakeDescription(samplers, sizes);
+
+	created = 0;
+	const auto hits = cache->GetHits();
+
+	FfxPipelineState first, second, other;
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(20), FFX_FSR2_PASS_LOCK, &description, &first, &CountingCreate), FFX_OK);
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(20), FFX_FSR2_PASS_LOCK, &description, &second, &CountingCreate), FFX_OK);
+	EXPECT_EQ(created, 1u);
+	EXPECT_EQ(cache->GetHits(), hits + 1);
+	EXPECT_EQ(second.pipeline, first.pipeline);
+
+	// Another device never gets the first device's objects
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(21), FFX_FSR2_PASS_LOCK, &description, &other, &CountingCreate), FFX_OK);
+	EXPECT_EQ(created, 2u);
+	EXPECT_NE(other.pipeline, first.pipeline);
+
+	// Neither does a different description
+	samplers[1] = FFX_FILTER_TYPE_POINT;
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(20), FFX_FSR2_PASS_LOCK, &description, &other, &CountingCreate), FFX_OK);
+	EXPECT_EQ(created, 3u);
+}
+
+TEST(PipelineCache, FlushesOnlyTheGivenDevice)
+{
+	auto cache = PipelineCache::GetSingleton();
+	FfxFilterType samplers[] = { FFX_FILTER_TYPE_POINT, FFX_FILTER_TYPE_LINEAR };
+	uint32_t sizes[] = { 54 };
+	auto description = MakeDescription(samplers, sizes);
+
+	FfxPipelineState state;
+	for (auto pass : { FFX_FSR2_PASS_LOCK, FFX_FSR2_PASS_ACCUMULATE, FFX_FSR2_PASS_RCAS }) {
+		ASSERT_EQ(cache->Create(nullptr, MakeDevice(22), pass, &description, &state, &CountingCreate), FFX_OK);
+		ASSERT_EQ(cache->Create(nullptr, MakeDevice(23), pass, &description, &state, &CountingCreate), FFX_OK);
+	}
+
+	destroyed = 0;
+	const auto cached = cache->GetCached();
+	EXPECT_EQ(cache->Flush(MakeDevice(22), nullptr, &CountingDestroy), 3u);
+	EXPECT_EQ(destroyed, 3u);
+	EXPECT_EQ(cache->GetCached(), cached - 3);
+	EXPECT_EQ(cache->Flush(MakeDevice(22), nullptr, &CountingDestroy), 0u);
+
+	// Flushed pipelines are created again on the next request
+	created = 0;
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(22), FFX_FSR2_PASS_LOCK, &description, &state, &CountingCreate), FFX_OK);
+	ASSERT_EQ(cache->Create(nullptr, MakeDevice(23), FFX_FSR2_PASS_LOCK, &description, &state, &CountingCreate), FFX_OK);
+	EXPECT_EQ(created, 1u);
+}
+
+TEST(PipelineCache, DestroyedDeviceTakesItsPipelines)
+{
+	auto pool = ContextPool::GetSingleton();
+	auto cache = PipelineCache::GetSingleton();
+	const auto cached = cache->GetCached();
+
+	Mock::Harness harness;
+	auto description = harness.MakeContextDescription({ 1920, 1080 }, { 2560, 1440 }, MakeDevice(24));
+	ASSERT_EQ(pool->Create(harness.context.get(), &description, &ffxFsr2ContextCreateMock), FFX_OK);
+	EXPECT_EQ(cache->GetCached(), cached + FFX_FSR2_PASS_COUNT);
+
+	// A returned context keeps them, its device going away does not
+	ASSERT_EQ(ffxFsr2ContextDestroyMock(harness.context.get()), FFX_OK);
+	EXPECT_EQ(cache->GetCached(), cached + FFX_FSR2_PASS_COUNT);
+
+	pool->ReleaseDevice(MakeDevice(24));
+	EXPECT_EQ(cache->GetCached(), cached);
+}
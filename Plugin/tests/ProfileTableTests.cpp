@@ -0,0 +1,73 @@
+#include "ProfileTable.h"
+
+#include <gtest/gtest.h>
+
+TEST(ProfileTable, FindsExactPairs)
+{
+	ProfileTable table;
+	ASSERT_TRUE(table.AddPair("quality", -0.25f, 2560, 1440, 3840, 2160));
+	ASSERT_TRUE(table.AddPair("performance", -0.5f, 1920, 1080, 3840, 2160));
+	ASSERT_TRUE(table.Compile());
+
+	auto profile = table.Find(1920, 1080, 3840, 2160);
+	ASSERT_NE(profile, nullptr);
+	EXPECT_EQ(profile->name, "performance");
+	EXPECT_EQ(profile->biasOffset, -0.5f);
+
+	EXPECT_EQ(table.Find(1920, 1080, 2560, 1440), nullptr);
+}
+
+TEST(ProfileTable, PairsWinOverScales)
+{
+	ProfileTable table;
+	ASSERT_TRUE(table.AddScale("half", 0.1f, 0.5f, 0.01f));
+	ASSERT_TRUE(table.AddPair("exact", 0.2f, 1920, 1080, 3840, 2160));
+	ASSERT_TRUE(table.Compile());
+
+	EXPECT_EQ(table.Find(1920, 1080, 3840, 2160)->name, "exact");
+	EXPECT_EQ(table.Find(1280, 720, 2560, 1440)->name, "half");
+	EXPECT_EQ(table.Find(3840, 2160, 3840, 2160), nullptr);
+	EXPECT_EQ(table.Find(1920, 1080, 0, 0), nullptr);
+}
+
+TEST(ProfileTable, EarlierScalesKeepTheirRange)
+{
+	ProfileTable table;
+	ASSERT_TRUE(table.AddScale("first", 1.0f, 0.5f, 0.05f));
+	ASSERT_TRUE(table.AddScale("second", 2.0f, 0.52f, 0.05f));
+	ASSERT_TRUE(table.Compile());
+
+	EXPECT_EQ(table.Find(1920, 1080, 3840, 2160)->name, "first");
+	EXPECT_EQ(table.Find(2150, 1210, 3840, 2160)->name, "second");
+}
+
+TEST(ProfileTable, RejectsInvalidEntries)
+{
+	ProfileTable table;
+	EXPECT_FALSE(table.AddScale("nan", 0.0f, std::numeric_limits<float>::quiet_NaN(), 0.01f));
+	EXPECT_FALSE(table.AddScale("negative", 0.0f, 0.5f, -0.01f));
+
+	ASSERT_TRUE(table.AddPair("a", 0.0f, 1920, 1080, 3840, 2160));
+	EXPECT_FALSE(table.AddPair("b", 0.0f, 1920, 1080, 3840, 2160));
+
+	// 0x10000 would alias 0 in the 16 bit key
+	EXPECT_FALSE(table.AddPair("wide", 0.0f, 0x10000 + 1920, 1080, 3840, 2160));
+	EXPECT_TRUE(table.AddPair("limit", 0.0f, ProfileTable::MaxDimension, 1080, 3840, 2160));
+
+	ASSERT_TRUE(table.Compile());
+	EXPECT_EQ(table.GetProfiles().size(), 2u);
+}
+
+TEST(ProfileTable, CompilesManyPairsWithoutCollisions)
+{
+	ProfileTable table;
+	for (uint32_t width = 640; width < 3840; width += 16)
+		ASSERT_TRUE(table.AddPair("p" + std::to_string(width), float(width), width, width * 9 / 16, 3840, 2160));
+	ASSERT_TRUE(table.Compile());
+
+	for (uint32_t width = 640; width < 3840; width += 16) {
+		auto profile = table.Find(width, width * 9 / 16, 3840, 2160);
+		ASSERT_NE(profile, nullptr);
+		EXPECT_EQ(profile->biasOffset, float(width));
+	}
+}
@@ -0,0 +1,38 @@
+#include "Qoi.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(Qoi, RoundTrips)
+{
+	constexpr uint32_t width = 37, height = 23;
+	std::vector<uint8_t> rgba(size_t(width) * height * 4);
+	for (size_t i = 0; i < rgba.size(); i++) {
+		// Runs, small differences, repeats and arbitrary values so every op is used
+		const auto pixel = i / 4;
+		rgba[i] = pixel < 100 ? uint8_t(7) : pixel < 300 ? uint8_t(pixel + i % 4) : uint8_t(pixel * 131 + i * 17);
+	}
+
+	const auto encoded = Qoi::Encode(rgba.data(), width, height);
+
+	std::vector<uint8_t> decoded;
+	uint32_t decodedWidth = 0, decodedHeight = 0;
+	ASSERT_TRUE(Qoi::Decode(encoded.data(), encoded.size(), decoded, decodedWidth, decodedHeight));
+	EXPECT_EQ(decodedWidth, width);
+	EXPECT_EQ(decodedHeight, height);
+	EXPECT_EQ(decoded, rgba);
+}
+
+TEST(Qoi, RejectsTruncatedData)
+{
+	std::vector<uint8_t> rgba(16 * 16 * 4);
+	for (size_t i = 0; i < rgba.size(); i++)
+		rgba[i] = uint8_t(i * 97);
+	const auto encoded = Qoi::Encode(rgba.data(), 16, 16);
+
+	std::vector<uint8_t> decoded;
+	uint32_t width, height;
+	EXPECT_FALSE(Qoi::Decode(encoded.data(), encoded.size() / 2, decoded, width, height));
+	EXPECT_FALSE(Qoi::Decode(encoded.data(), 10, decoded, width, height));
+}
@@ -0,0 +1,121 @@
+#include "RenderExtentTracker.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	constexpr FfxDimensions2D Display{ 2560, 1440 };
+
+	// A frame with a shadow map and the scene depth at this render size
+	void Frame(RenderExtentTracker& tracker, FfxDimensions2D render, FfxDimensions2D display = Display)
+	{
+		for (int i = 0; i < 8; i++)
+			tracker.CountBind(2048, 2048);
+		for (uint32_t i = 0; i < RenderExtentTracker::MinBinds; i++)
+			tracker.CountBind(render.width, render.height);
+		tracker.EndFrame(display);
+	}
+
+	void EmptyFrame(RenderExtentTracker& tracker)
+	{
+		tracker.EndFrame(Display);
+	}
+
+	bool Detected(const RenderExtentTracker& tracker, FfxDimensions2D expected)
+	{
+		FfxDimensions2D render{};
+		return tracker.GetRenderSize(render) && render.width == expected.width && render.height == expected.height;
+	}
+}
+
+TEST(RenderExtentTracker, DetectsOnceStable)
+{
+	RenderExtentTracker tracker;
+	FfxDimensions2D render{};
+
+	for (uint32_t i = 1; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1707, 960 });
+	EXPECT_FALSE(tracker.GetRenderSize(render));
+
+	Frame(tracker, { 1707, 960 });
+	EXPECT_TRUE(Detected(tracker, { 1707, 960 }));
+}
+
+TEST(RenderExtentTracker, IgnoresOtherAspectRatiosAndFewBinds)
+{
+	RenderExtentTracker tracker;
+	FfxDimensions2D render{};
+
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames * 2; i++) {
+		for (int bind = 0; bind < 50; bind++)
+			tracker.CountBind(1024, 1024);
+		for (uint32_t bind = 1; bind < RenderExtentTracker::MinBinds; bind++)
+			tracker.CountBind(1280, 720);
+		tracker.EndFrame(Display);
+	}
+	EXPECT_FALSE(tracker.GetRenderSize(render));
+}
+
+TEST(RenderExtentTracker, DropsTheRenderSizeOnceUnstable)
+{
+	RenderExtentTracker tracker;
+	FfxDimensions2D render{};
+
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1707, 960 });
+	ASSERT_TRUE(Detected(tracker, { 1707, 960 }));
+
+	// A short gap, e.g. a frame without a depth pass, keeps the render size
+	EmptyFrame(tracker);
+	Frame(tracker, { 1707, 960 });
+	EXPECT_TRUE(Detected(tracker, { 1707, 960 }));
+
+	// A menu without a scene depth pass
+	for (uint32_t i = 1; i < RenderExtentTracker::StableFrames; i++)
+		EmptyFrame(tracker);
+	EXPECT_TRUE(Detected(tracker, { 1707, 960 }));
+	EmptyFrame(tracker);
+	EXPECT_FALSE(tracker.GetRenderSize(render));
+
+	// Alternating winners are not stable either
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1707, 960 });
+	ASSERT_TRUE(Detected(tracker, { 1707, 960 }));
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, i % 2 ? FfxDimensions2D{ 1280, 720 } : FfxDimensions2D{ 1920, 1080 });
+	EXPECT_FALSE(tracker.GetRenderSize(render));
+}
+
+TEST(RenderExtentTracker, FollowsAResolutionChange)
+{
+	RenderExtentTracker tracker;
+
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1707, 960 });
+	ASSERT_TRUE(Detected(tracker, { 1707, 960 }));
+
+	// The old size is kept until the new one is stable
+	for (uint32_t i = 1; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1280, 720 });
+	EXPECT_TRUE(Detected(tracker, { 1707, 960 }));
+	Frame(tracker, { 1280, 720 });
+	EXPECT_TRUE(Detected(tracker, { 1280, 720 }));
+}
+
+TEST(RenderExtentTracker, DropsTheRenderSizeWhenTheDisplayChanges)
+{
+	RenderExtentTracker tracker;
+	FfxDimensions2D render{};
+
+	for (uint32_t i = 0; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1280, 720 });
+	ASSERT_TRUE(Detected(tracker, { 1280, 720 }));
+
+	// Same render size, still a valid pick at the new display size, but detection starts over
+	Frame(tracker, { 1280, 720 }, { 1920, 1080 });
+	EXPECT_FALSE(tracker.GetRenderSize(render));
+
+	for (uint32_t i = 1; i < RenderExtentTracker::StableFrames; i++)
+		Frame(tracker, { 1280, 720 }, { 1920, 1080 });
+	EXPECT_TRUE(Detected(tracker, { 1280, 720 }));
+}
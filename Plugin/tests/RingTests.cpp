@@ -0,0 +1,135 @@
+#include "InplaceFunction.h"
+#include "MpscRing.h"
+#include "SpscRing.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST(SpscRing, KeepsOrderAndCapacity)
+{
+	SpscRing<int, 4> ring;
+	EXPECT_TRUE(ring.Empty());
+	for (int i = 0; i < 4; i++)
+		EXPECT_TRUE(ring.Push(i));
+	EXPECT_FALSE(ring.Push(4));
+
+	int value;
+	for (int i = 0; i < 4; i++) {
+		ASSERT_TRUE(ring.Pop(value));
+		EXPECT_EQ(value, i);
+	}
+	EXPECT_FALSE(ring.Pop(value));
+	EXPECT_TRUE(ring.Empty());
+}
+
+TEST(MpscRing, KeepsOrderAndCapacity)
+{
+	MpscRing<int, 4> ring;
+	for (int i = 0; i < 4; i++)
+		EXPECT_TRUE(ring.Push(i));
+	EXPECT_FALSE(ring.Push(4));
+
+	int value;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 4; i++) {
+			ASSERT_TRUE(ring.Pop(value));
+			EXPECT_EQ(value, round * 4 + i);
+			EXPECT_TRUE(ring.Push(round * 4 + i + 4));
+		}
+	}
+}
+
+TEST(MpscRing, DeliversEveryProducersItemsInOrder)
+{
+	constexpr int Producers = 4;
+	constexpr int PerProducer = 100000;
+
+	MpscRing<int, 256> ring;
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < Producers; producer++) {
+		producers.emplace_back([&, producer] {
+			for (int i = 0; i < PerProducer; i++) {
+				while (!ring.Push(producer * PerProducer + i))
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	std::vector<int> next(Producers, 0);
+	for (int received = 0; received < Producers * PerProducer;) {
+		int value;
+		if (!ring.Pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		const auto producer = value / PerProducer;
+		ASSERT_EQ(value % PerProducer, next[producer]);
+		next[producer]++;
+		received++;
+	}
+
+	for (auto& thread : producers)
+		thread.join();
+}
+
+TEST(SpscRing, StressKeepsOrderAcrossThreads)
+{
+	// Small enough that the producer keeps running into a full ring
+	SpscRing<uint64_t, 64> ring;
+	constexpr uint64_t Count = 1000000;
+
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < Count; i++) {
+			while (!ring.Push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	uint64_t expected = 0, value;
+	while (expected < Count) {
+		if (!ring.Pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(value, expected);
+		expected++;
+	}
+	producer.join();
+	EXPECT_TRUE(ring.Empty());
+}
+
+TEST(SpscRing, StressRunsJobsInOrderAndReleasesThem)
+{
+	// What a worker queue holds: jobs with captures that must be released once popped
+	SpscRing<InplaceFunction<48>, 64> ring;
+	constexpr uint64_t Count = 200000;
+	auto alive = std::make_shared<int>(0);
+	uint64_t ran = 0;
+	bool ordered = true;
+
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < Count; i++) {
+			InplaceFunction<48> job([&ran, &ordered, alive, i] {
+				ordered &= ran == i;
+				ran++;
+			});
+			while (!ring.Push(std::move(job)))
+				std::this_thread::yield();
+		}
+	});
+
+	InplaceFunction<48> job;
+	while (ran < Count) {
+		if (!ring.Pop(job)) {
+			std::this_thread::yield();
+			continue;
+		}
+		job();
+		job = nullptr;
+	}
+	producer.join();
+	EXPECT_TRUE(ordered);
+	EXPECT_EQ(alive.use_count(), 1);
+}
@@ -0,0 +1,75 @@
+#include "SeqLock.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Pair
+	{
+		uint64_t value = 0;
+		uint64_t check = ~0ull;  // ~value
+		float extra = 0.0f;
+	};
+}
+
+TEST(SeqLock, StoresAndUpdates)
+{
+	SeqLock<Pair> lock;
+	EXPECT_EQ(lock.Load().check, ~0ull);
+
+	lock.Store({ 1, ~1ull, 0.5f });
+	EXPECT_EQ(lock.Load().value, 1u);
+	EXPECT_EQ(lock.Load().extra, 0.5f);
+
+	// Update only touches its part of the value
+	lock.Update([](Pair& pair) { pair.extra = 2.0f; });
+	const auto pair = lock.Load();
+	EXPECT_EQ(pair.value, 1u);
+	EXPECT_EQ(pair.check, ~1ull);
+	EXPECT_EQ(pair.extra, 2.0f);
+}
+
+TEST(SeqLock, ReadersNeverSeeTornWrites)
+{
+	constexpr uint64_t Writes = 100000;
+
+	SeqLock<Pair> lock;
+	std::atomic<bool> done = false;
+
+	// Two writers each own a part of the value, as the dispatch hook and bias detection do
+	std::thread values([&] {
+		for (uint64_t i = 1; i <= Writes; i++)
+			lock.Update([i](Pair& pair) { pair.value = i, pair.check = ~i; });
+	});
+	std::thread extras([&] {
+		for (uint64_t i = 1; i <= Writes; i++)
+			lock.Update([i](Pair& pair) { pair.extra = float(i); });
+	});
+
+	std::vector<std::thread> readers;
+	std::atomic<uint64_t> torn = 0;
+	for (int i = 0; i < 2; i++) {
+		readers.emplace_back([&] {
+			uint64_t last = 0;
+			while (!done.load(std::memory_order_relaxed)) {
+				const auto pair = lock.Load();
+				if (pair.check != ~pair.value || pair.value < last)
+					torn++;
+				last = pair.value;
+			}
+		});
+	}
+
+	values.join();
+	extras.join();
+	done = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	EXPECT_EQ(torn.load(), 0u);
+	EXPECT_EQ(lock.Load().value, Writes);
+	EXPECT_EQ(lock.Load().extra, float(Writes));
+}
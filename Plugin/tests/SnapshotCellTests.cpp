@@ -0,0 +1,124 @@
+#include "SnapshotCell.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr uint64_t Alive = 0xA11CE;
+
+	struct Snapshot
+	{
+		uint64_t value;
+		uint64_t check;  // value ^ Alive while alive
+
+		explicit Snapshot(uint64_t value) :
+			value(value), check(value ^ Alive) {}
+		~Snapshot() { check = 0; }
+
+		bool Valid() const { return check == (value ^ Alive); }
+	};
+
+	const Snapshot Initial{ 0 };
+}
+
+TEST(SnapshotCell, FreesReplacedSnapshotsOnceUnread)
+{
+	SnapshotCell<Snapshot, 4> cell(&Initial);
+	EXPECT_EQ(cell.Read()->value, 0u);
+
+	const auto first = cell.Publish(std::make_unique<Snapshot>(1));
+	EXPECT_EQ(cell.Read().get(), first);
+	{
+		const auto guard = cell.Read();
+		cell.Publish(std::make_unique<Snapshot>(2));
+		cell.Publish(std::make_unique<Snapshot>(3));
+
+		// The guard may still see the first snapshot, and so the second
+		EXPECT_EQ(cell.Reclaim(), 2u);
+		EXPECT_TRUE(guard->Valid());
+		EXPECT_EQ(guard->value, 1u);
+	}
+	EXPECT_EQ(cell.Reclaim(), 0u);
+
+	// A guard taken after a publish does not hold back what was replaced before it
+	const auto guard = cell.Read();
+	cell.Publish(std::make_unique<Snapshot>(4));
+	EXPECT_EQ(guard->value, 3u);
+	EXPECT_EQ(cell.Reclaim(), 1u);
+	EXPECT_EQ(cell.Read()->value, 4u);
+}
+
+TEST(SnapshotCell, NestedGuardsTakeSlotsOfTheirOwn)
+{
+	SnapshotCell<Snapshot, 4> cell(&Initial);
+	cell.Publish(std::make_unique<Snapshot>(1));
+	{
+		auto outer = cell.Read();
+		{
+			const auto inner = cell.Read();
+			cell.Publish(std::make_unique<Snapshot>(2));
+		}
+		EXPECT_EQ(cell.Reclaim(), 1u);
+		EXPECT_EQ(outer->value, 1u);
+
+		// Moving a guard keeps its pin
+		const auto moved = std::move(outer);
+		EXPECT_EQ(cell.Reclaim(), 1u);
+		EXPECT_EQ(moved->value, 1u);
+	}
+	EXPECT_EQ(cell.Reclaim(), 0u);
+	EXPECT_FALSE(cell.Overflowed());
+}
+
+TEST(SnapshotCell, KeepsEverythingAfterRunningOutOfSlots)
+{
+	SnapshotCell<Snapshot, 2> cell(&Initial);
+	cell.Publish(std::make_unique<Snapshot>(1));
+	{
+		const auto first = cell.Read();
+		const auto second = cell.Read();
+		const auto unpinned = cell.Read();
+		EXPECT_TRUE(cell.Overflowed());
+		EXPECT_EQ(unpinned->value, 1u);
+	}
+
+	cell.Publish(std::make_unique<Snapshot>(2));
+	EXPECT_EQ(cell.Reclaim(), 1u);
+}
+
+TEST(SnapshotCell, ReadersNeverSeeAFreedSnapshot)
+{
+	SnapshotCell<Snapshot, 8> cell(&Initial);
+	constexpr size_t Readers = 4;
+	constexpr uint64_t Publishes = 20000;
+	std::atomic<bool> done = false;
+	std::atomic<uint64_t> invalid = 0;
+
+	std::vector<std::thread> readers;
+	for (size_t i = 0; i < Readers; i++) {
+		readers.emplace_back([&] {
+			uint64_t last = 0;
+			while (!done.load(std::memory_order_relaxed)) {
+				const auto guard = cell.Read();
+				if (!guard->Valid() || guard->value < last)
+					invalid.fetch_add(1, std::memory_order_relaxed);
+				last = guard->value;
+			}
+		});
+	}
+
+	for (uint64_t i = 1; i <= Publishes; i++) {
+		cell.Publish(std::make_unique<Snapshot>(i));
+		cell.Reclaim();
+	}
+	done = true;
+	for (auto& reader : readers)
+		reader.join();
+
+	EXPECT_EQ(invalid.load(), 0u);
+	EXPECT_FALSE(cell.Overflowed());
+	EXPECT_EQ(cell.Reclaim(), 0u);
+}
@@ -0,0 +1,95 @@
+#include "StaleSamplers.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	constexpr uint64_t Stride = 32;
+
+	// Two devices with samplers interleaved, the way descriptor slots of separate heaps sort
+	StaleSamplers MakeTable()
+	{
+		return { 7, {
+						{ 2, 0x1000 + 3 * Stride, 0xB3, 0 },
+						{ 1, 0x1000 + 2 * Stride, 0xA2, 0xC2 },
+						{ 1, 0x1000, 0xA0, 0 },
+						{ 2, 0x1000, 0xB0, 0xD0 },
+						{ 1, 0x1000 + 5 * Stride, 0, 0xC5 },
+					} };
+	}
+
+	using Writes = std::vector<std::pair<uint32_t, uint64_t>>;
+}
+
+TEST(StaleSamplers, FindsStaleSamplersOfTheirDevice)
+{
+	const auto table = MakeTable();
+	EXPECT_EQ(table.GetVersion(), 7u);
+	EXPECT_EQ(table.Size(), 5u);
+
+	EXPECT_EQ(table.Find(1, 0x1000, false), 0xA0u);
+	EXPECT_EQ(table.Find(1, 0x1000 + 2 * Stride, false), 0xA2u);
+	EXPECT_EQ(table.Find(2, 0x1000, false), 0xB0u);
+	EXPECT_EQ(table.Find(1, 0x1000 + 3 * Stride, false), 0u);
+	EXPECT_EQ(table.Find(3, 0x1000, false), 0u);
+	EXPECT_EQ(StaleSamplers().Find(1, 0x1000, false), 0u);
+}
+
+TEST(StaleSamplers, PicksTheReplacementOfThePass)
+{
+	const auto table = MakeTable();
+
+	// Already written with the current bias, only a pass that keeps samplers unbiased replaces it
+	EXPECT_EQ(table.Find(1, 0x1000 + 5 * Stride, false), 0u);
+	EXPECT_EQ(table.Find(1, 0x1000 + 5 * Stride, true), 0xC5u);
+
+	// Written without bias, only a biased pass replaces it
+	EXPECT_EQ(table.Find(1, 0x1000, false), 0xA0u);
+	EXPECT_EQ(table.Find(1, 0x1000, true), 0u);
+
+	Writes writes;
+	table.ForEachStale(1, 0x1000, Stride, 6, true, [&](uint32_t index, uint64_t replacement) { writes.emplace_back(index, replacement); });
+	EXPECT_EQ(writes, (Writes{ { 2, 0xC2 }, { 5, 0xC5 } }));
+}
+
+TEST(StaleSamplers, WalksCopiedRanges)
+{
+	const auto table = MakeTable();
+
+	Writes writes;
+	auto record = [&](uint32_t index, uint64_t replacement) { writes.emplace_back(index, replacement); };
+
+	// A copy of six descriptors from the start of device 1's heap
+	EXPECT_EQ(table.ForEachStale(1, 0x1000, Stride, 6, false, record), 2u);
+	EXPECT_EQ(writes, (Writes{ { 0, 0xA0 }, { 2, 0xA2 } }));
+
+	// The range starts after the first one
+	writes.clear();
+	EXPECT_EQ(table.ForEachStale(2, 0x1000 + Stride, Stride, 4, false, record), 1u);
+	EXPECT_EQ(writes, (Writes{ { 2, 0xB3 } }));
+
+	// The range ends before the last one
+	writes.clear();
+	EXPECT_EQ(table.ForEachStale(2, 0x1000, Stride, 3, false, record), 1u);
+	EXPECT_EQ(writes, (Writes{ { 0, 0xB0 } }));
+
+	// Handles between descriptor slots are not part of the range
+	writes.clear();
+	EXPECT_EQ(table.ForEachStale(2, 0x1000 + Stride / 2, Stride, 4, false, record), 0u);
+	EXPECT_TRUE(writes.empty());
+}
+
+TEST(StaleSamplers, DirectlyCreatedSamplersAreOnlyRewrittenWhenCopied)
+{
+	// A stale sampler the game created straight into a shader-visible heap is listed like any other, but
+	// the game never copies from that heap. Copies into it only rewrite what they read from elsewhere, the
+	// slot itself keeps the bias it was created with.
+	constexpr uint64_t ShaderVisible = 0x8000;
+	const StaleSamplers table(1, { { 1, 0x1000, 0xA0, 0 }, { 1, ShaderVisible + Stride, 0xC1, 0 } });
+
+	std::vector<uint32_t> rewritten;
+	table.ForEachStale(1, 0x1000 + Stride, Stride, 4, false, [&](uint32_t index, uint64_t) { rewritten.push_back(index); });
+	EXPECT_TRUE(rewritten.empty());
+	table.ForEachStale(1, 0x1000, Stride, 1, false, [&](uint32_t index, uint64_t) { rewritten.push_back(index); });
+	EXPECT_EQ(rewritten, std::vector<uint32_t>{ 0 });
+}
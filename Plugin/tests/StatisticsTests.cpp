@@ -0,0 +1,33 @@
+#include "Statistics.h"
+
+#include <gtest/gtest.h>
+
+TEST(RollingWindow, KeepsLastSamples)
+{
+	RollingWindow<4> window;
+	EXPECT_EQ(window.Median(), 0.0f);
+
+	for (float sample : { 100.0f, 1.0f, 2.0f, 3.0f, 4.0f })
+		window.Add(sample);
+	EXPECT_TRUE(window.Full());
+	EXPECT_EQ(window.Size(), 4u);
+	EXPECT_EQ(window.Median(), 3.0f);
+	EXPECT_NEAR(window.Stddev(), 1.118034f, 1e-5f);
+
+	window.Clear();
+	EXPECT_EQ(window.Size(), 0u);
+}
+
+TEST(RunningStats, TracksMoments)
+{
+	RunningStats stats;
+	EXPECT_EQ(stats.Mean(), 0.0);
+
+	for (int64_t sample : { 2, 4, 4, 4, 5, 5, 7, 9 })
+		stats.Add(sample);
+	EXPECT_EQ(stats.count, 8u);
+	EXPECT_EQ(stats.min, 2);
+	EXPECT_EQ(stats.max, 9);
+	EXPECT_DOUBLE_EQ(stats.Mean(), 5.0);
+	EXPECT_DOUBLE_EQ(stats.Stddev(), 2.0);
+}
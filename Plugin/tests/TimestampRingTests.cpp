@@ -0,0 +1,127 @@
+#include "TimestampRing.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+// Drives the ring the way GpuProfiler does, against a fake device whose query results only become
+// available a number of presents after they were written.
+namespace
+{
+	constexpr uint64_t Frequency = 1000000;  // ticks per second, a tick is a microsecond
+
+	struct FakeDevice
+	{
+		uint64_t gpuLag = 1;  // presents until written timestamps can be read
+		uint64_t presents = 0;
+		uint64_t clock = 0;
+		std::array<uint64_t, TimestampRing::QueryCount> ticks{};
+		std::array<uint64_t, TimestampRing::QueryCount> writtenAt{};
+
+		void Write(int32_t query, uint64_t duration = 0)
+		{
+			clock += duration;
+			ticks[size_t(query)] = clock;
+			writtenAt[size_t(query)] = presents;
+		}
+
+		bool Read(uint32_t first, uint32_t count, uint64_t* out) const
+		{
+			for (uint32_t i = first; i < first + count; i++) {
+				if (presents - writtenAt[i] < gpuLag)
+					return false;
+				out[i - first] = ticks[i];
+			}
+			return true;
+		}
+	};
+
+	struct Profiler
+	{
+		FakeDevice device;
+		TimestampRing ring;
+		std::vector<double> results;
+
+		// A dispatch taking microseconds on the GPU, returns false if it was not measured
+		bool Dispatch(uint64_t microseconds)
+		{
+			const auto query = ring.Begin();
+			if (query < 0)
+				return false;
+			device.Write(query);
+			device.Write(query + 1, microseconds);
+			ring.End(query);
+			return true;
+		}
+
+		void Present()
+		{
+			device.presents++;
+			ring.Present();
+			ring.Resolve(
+				Frequency,
+				[&](uint32_t first, uint32_t count, uint64_t* ticks) { return device.Read(first, count, ticks); },
+				[&](double milliseconds) { results.push_back(milliseconds); });
+		}
+	};
+}
+
+TEST(TimestampRing, WaitsForPresentsNotDispatches)
+{
+	// Two dispatches per frame used to age the ring twice as fast
+	Profiler profiler;
+	profiler.device.gpuLag = 0;
+	ASSERT_TRUE(profiler.Dispatch(1000));
+	ASSERT_TRUE(profiler.Dispatch(2000));
+
+	profiler.Present();
+	EXPECT_TRUE(profiler.results.empty());
+
+	profiler.Present();
+	ASSERT_EQ(profiler.results.size(), 2u);
+	EXPECT_DOUBLE_EQ(profiler.results[0], 1.0);
+	EXPECT_DOUBLE_EQ(profiler.results[1], 2.0);
+}
+
+TEST(TimestampRing, SkipsDispatchesWhileTheRingIsFull)
+{
+	Profiler profiler;
+	for (uint32_t i = 0; i < TimestampRing::Slots; i++)
+		EXPECT_TRUE(profiler.Dispatch(100));
+	EXPECT_FALSE(profiler.Dispatch(100));
+
+	for (uint64_t i = 0; i < TimestampRing::Latency; i++)
+		profiler.Present();
+	EXPECT_EQ(profiler.results.size(), TimestampRing::Slots);
+	EXPECT_TRUE(profiler.Dispatch(100));
+}
+
+TEST(TimestampRing, RetriesResultsTheGpuHasNotWritten)
+{
+	Profiler profiler;
+	profiler.device.gpuLag = TimestampRing::Latency + 2;
+	ASSERT_TRUE(profiler.Dispatch(500));
+
+	for (uint64_t i = 0; i < TimestampRing::Latency + 1; i++)
+		profiler.Present();
+	EXPECT_TRUE(profiler.results.empty());
+
+	profiler.Present();
+	ASSERT_EQ(profiler.results.size(), 1u);
+	EXPECT_DOUBLE_EQ(profiler.results[0], 0.5);
+}
+
+TEST(TimestampRing, AbandonedAndClearedMeasurementsFreeTheirSlots)
+{
+	Profiler profiler;
+	const auto query = profiler.ring.Begin();
+	ASSERT_GE(query, 0);
+	profiler.ring.Abandon(query);
+	EXPECT_EQ(profiler.ring.Begin(), query);
+
+	profiler.ring.Clear();
+	for (uint32_t i = 0; i < TimestampRing::Slots; i++)
+		EXPECT_TRUE(profiler.Dispatch(100));
+	profiler.ring.Clear();
+	EXPECT_TRUE(profiler.Dispatch(100));
+}
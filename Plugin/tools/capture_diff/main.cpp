@@ -0,0 +1,184 @@
+// Compares the A/B screenshot pairs written by the plugin's capture mode (pair_NNN_a.qoi with the fix,
+// pair_NNN_b.qoi force-disabled) and prints one CSV row per pair:
+//
+//   capture_diff <capture directory> [> result.csv]
+//
+// mse/psnr are over RGB, sharpness is the variance of the Laplacian of luma, a common focus measure that
+// rises with texture detail. A sharpness ratio above 1 means the bias recovered detail.
+
+#include "Qoi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#ifdef __SSE2__
+#	include <emmintrin.h>
+#endif
+
+namespace
+{
+	struct Image
+	{
+		std::vector<uint8_t> rgba;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	bool Load(const std::filesystem::path& path, Image& image)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return Qoi::Decode(data.data(), data.size(), image.rgba, image.width, image.height);
+	}
+
+	// Sum of squared RGB differences, alpha is ignored
+	uint64_t SquaredError(const uint8_t* a, const uint8_t* b, size_t pixels)
+	{
+		uint64_t sum = 0;
+		size_t i = 0;
+
+#ifdef __SSE2__
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+		// 4 pixels per iteration; each 32-bit lane holds at most 4 * 2 * 255^2, flushed every 1024 iterations
+		while (i + 4 <= pixels) {
+			__m128i acc = _mm_setzero_si128();
+			const size_t end = std::min(pixels & ~size_t(3), i + 4 * 1024);
+			for (; i < end; i += 4) {
+				const __m128i va = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 4)), rgbMask);
+				const __m128i vb = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 4)), rgbMask);
+				const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero));
+				const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero));
+				acc = _mm_add_epi32(acc, _mm_madd_epi16(lo, lo));
+				acc = _mm_add_epi32(acc, _mm_madd_epi16(hi, hi));
+			}
+			uint32_t lanes[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+			sum += uint64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+		}
+#endif
+
+		for (; i < pixels; i++) {
+			for (int c = 0; c < 3; c++) {
+				const int d = int(a[i * 4 + c]) - int(b[i * 4 + c]);
+				sum += uint64_t(d * d);
+			}
+		}
+		return sum;
+	}
+
+	std::vector<float> Luma(const Image& image)
+	{
+		std::vector<float> luma(size_t(image.width) * image.height);
+		for (size_t i = 0; i < luma.size(); i++) {
+			const uint8_t* p = &image.rgba[i * 4];
+			luma[i] = 0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2];
+		}
+		return luma;
+	}
+
+	// Variance of the 4-neighbour Laplacian over the interior pixels
+	double Sharpness(const Image& image)
+	{
+		if (image.width < 3 || image.height < 3)
+			return 0.0;
+
+		const auto luma = Luma(image);
+		const size_t w = image.width;
+		double sum = 0.0, sumSquares = 0.0;
+
+		for (size_t y = 1; y + 1 < image.height; y++) {
+			const float* up = &luma[(y - 1) * w];
+			const float* row = &luma[y * w];
+			const float* down = &luma[(y + 1) * w];
+			size_t x = 1;
+
+#ifdef __SSE2__
+			// Per row accumulation in float keeps the sums exact enough for 8-bit input
+			__m128 rowSum = _mm_setzero_ps();
+			__m128 rowSquares = _mm_setzero_ps();
+			const __m128 four = _mm_set1_ps(4.0f);
+			for (; x + 4 < w; x += 4) {
+				const __m128 center = _mm_loadu_ps(row + x);
+				const __m128 neighbours = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x)), _mm_add_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)));
+				const __m128 laplacian = _mm_sub_ps(neighbours, _mm_mul_ps(center, four));
+				rowSum = _mm_add_ps(rowSum, laplacian);
+				rowSquares = _mm_add_ps(rowSquares, _mm_mul_ps(laplacian, laplacian));
+			}
+			float lanes[4], squareLanes[4];
+			_mm_storeu_ps(lanes, rowSum);
+			_mm_storeu_ps(squareLanes, rowSquares);
+			for (int i = 0; i < 4; i++) {
+				sum += lanes[i];
+				sumSquares += squareLanes[i];
+			}
+#endif
+
+			for (; x + 1 < w; x++) {
+				const double laplacian = double(up[x]) + down[x] + row[x - 1] + row[x + 1] - 4.0 * row[x];
+				sum += laplacian;
+				sumSquares += laplacian * laplacian;
+			}
+		}
+
+		const double count = double(image.width - 2) * double(image.height - 2);
+		const double mean = sum / count;
+		return sumSquares / count - mean * mean;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 2) {
+		std::fprintf(stderr, "usage: %s <capture directory>\n", argv[0]);
+		return 1;
+	}
+
+	const std::filesystem::path directory = argv[1];
+	std::printf("pair,width,height,mse,psnr_db,sharpness_a,sharpness_b,sharpness_ratio\n");
+
+	int compared = 0;
+	for (int pair = 0;; pair++) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "pair_%03d_a.qoi", pair);
+		const auto pathA = directory / name;
+		std::snprintf(name, sizeof(name), "pair_%03d_b.qoi", pair);
+		const auto pathB = directory / name;
+		if (!std::filesystem::exists(pathA) || !std::filesystem::exists(pathB))
+			break;
+
+		Image a, b;
+		if (!Load(pathA, a) || !Load(pathB, b)) {
+			std::fprintf(stderr, "pair %d: failed to decode\n", pair);
+			continue;
+		}
+		if (a.width != b.width || a.height != b.height) {
+			std::fprintf(stderr, "pair %d: size mismatch %ux%u vs %ux%u\n", pair, a.width, a.height, b.width, b.height);
+			continue;
+		}
+
+		const size_t pixels = size_t(a.width) * a.height;
+		const double mse = double(SquaredError(a.rgba.data(), b.rgba.data(), pixels)) / double(pixels * 3);
+		const double psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : INFINITY;
+		const double sharpnessA = Sharpness(a);
+		const double sharpnessB = Sharpness(b);
+
+		std::printf("%d,%u,%u,%.4f,%.2f,%.2f,%.2f,%.4f\n", pair, a.width, a.height, mse, psnr, sharpnessA, sharpnessB, sharpnessB > 0.0 ? sharpnessA / sharpnessB : 0.0);
+		compared++;
+	}
+
+	if (!compared) {
+		std::fprintf(stderr, "no pairs found in %s\n", directory.string().c_str());
+		return 1;
+	}
+	return 0;
+}
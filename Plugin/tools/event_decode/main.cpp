@@ -0,0 +1,145 @@
+// Decodes a binary event log written by the plugin (UpscalingFix.events.bin, see core/EventFormat.h):
+//
+//   event_decode <file> [text|csv|json] [> output]
+//
+// text reproduces the lines the text log would have had, csv and json keep the typed arguments.
+
+#include "EventDecoder.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const char* LevelName(EventFormat::Level level)
+	{
+		switch (level) {
+		case EventFormat::Level::Debug:
+			return "debug";
+		case EventFormat::Level::Info:
+			return "info";
+		default:
+			return "error";
+		}
+	}
+
+	std::string CsvField(const std::string& text)
+	{
+		std::string quoted = "\"";
+		for (char c : text) {
+			if (c == '"')
+				quoted += '"';
+			quoted += c;
+		}
+		return quoted + '"';
+	}
+
+	std::string JsonString(const std::string& text)
+	{
+		std::string quoted = "\"";
+		for (unsigned char c : text) {
+			if (c == '"' || c == '\\') {
+				quoted += '\\';
+				quoted += c;
+			} else if (c < 0x20) {
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				quoted += escaped;
+			} else {
+				quoted += c;
+			}
+		}
+		return quoted + '"';
+	}
+
+	std::string ArgText(char type, const EventFormat::Arg& arg)
+	{
+		char buffer[64];
+		if (type == 'i')
+			std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(arg.i));
+		else
+			std::snprintf(buffer, sizeof(buffer), "%.17g", arg.f);
+		return buffer;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || argc > 3) {
+		std::fprintf(stderr, "usage: %s <file> [text|csv|json]\n", argv[0]);
+		return 1;
+	}
+
+	const std::string mode = argc == 3 ? argv[2] : "text";
+	if (mode != "text" && mode != "csv" && mode != "json") {
+		std::fprintf(stderr, "unknown output format %s\n", mode.c_str());
+		return 1;
+	}
+
+	std::ifstream file(argv[1], std::ios::binary);
+	if (!file) {
+		std::fprintf(stderr, "failed to open %s\n", argv[1]);
+		return 1;
+	}
+	EventDecoder decoder(file);
+
+	switch (decoder.ReadHeader()) {
+	case EventDecoder::Status::Ok:
+		break;
+	case EventDecoder::Status::UnsupportedVersion:
+		std::fprintf(stderr, "unsupported event log version %u\n", decoder.GetVersion());
+		return 1;
+	case EventDecoder::Status::TruncatedHeader:
+		std::fprintf(stderr, "truncated header\n");
+		return 1;
+	default:
+		std::fprintf(stderr, "%s is not an event log\n", argv[1]);
+		return 1;
+	}
+	const auto& definitions = decoder.GetDefinitions();
+
+	if (mode == "csv")
+		std::printf("time_us,event,level,suppressed,message,arg0,arg1,arg2,arg3\n");
+	else if (mode == "json")
+		std::printf("{\"start_unix_us\":%lld,\"records\":[", static_cast<long long>(decoder.GetStartTime()));
+
+	size_t records = 0;
+	EventDecoder::Record record;
+	while (true) {
+		const auto status = decoder.Next(record);
+		if (status == EventDecoder::Status::End)
+			break;
+		if (status != EventDecoder::Status::Ok) {
+			std::fprintf(stderr, status == EventDecoder::Status::TruncatedRecord ? "truncated record %zu\n" : "truncated or corrupt record %zu\n", records);
+			break;
+		}
+
+		const auto& definition = definitions[record.event];
+		const auto& args = record.args;
+		const auto time = record.time;
+		const auto suppressed = record.suppressed;
+		auto message = EventFormat::Format(definition.format, definition.types, args.data());
+		if (mode == "text") {
+			if (suppressed)
+				message += " (" + std::to_string(suppressed) + " similar events suppressed)";
+			std::printf("[%12.6f] [%s] %s\n", double(time) / 1e6, LevelName(definition.level), message.c_str());
+		} else if (mode == "csv") {
+			std::printf("%lld,%s,%s,%u,%s", static_cast<long long>(time), definition.name.c_str(), LevelName(definition.level), suppressed, CsvField(message).c_str());
+			for (size_t i = 0; i < 4; i++)
+				std::printf(",%s", i < args.size() ? ArgText(definition.types[i], args[i]).c_str() : "");
+			std::printf("\n");
+		} else {
+			std::printf("%s\n{\"time_us\":%lld,\"event\":%s,\"level\":\"%s\",\"suppressed\":%u,\"message\":%s,\"args\":[", records ? "," : "", static_cast<long long>(time), JsonString(definition.name).c_str(), LevelName(definition.level), suppressed, JsonString(message).c_str());
+			for (size_t i = 0; i < args.size(); i++)
+				std::printf("%s%s", i ? "," : "", ArgText(definition.types[i], args[i]).c_str());
+			std::printf("]}");
+		}
+		records++;
+	}
+
+	if (mode == "json")
+		std::printf("\n]}\n");
+	return 0;
+}